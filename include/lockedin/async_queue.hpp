@@ -0,0 +1,482 @@
+/**
+ * @file async_queue.hpp
+ * @brief C++20 **coroutine adaptors** for lockedin queues and a minimal single-threaded
+ *        scheduler.
+ *
+ * ```cpp
+ * CoScheduler sched;
+ * AsyncQ<Order, SPSCQ<Order>> orders(sched, 1024);
+ * // The closures must outlive their tasks: a coroutine lambda only keeps a pointer to them.
+ * auto consume = [&]() -> CoTask { for (;;) handle(co_await orders.async_pop()); };
+ * auto produce = [&]() -> CoTask { co_await orders.async_push(Order{...}); };
+ * sched.spawn(consume());
+ * sched.spawn(produce());
+ * sched.run();
+ * ```
+ *
+ * * `async_pop()` / `async_push(v)` complete immediately when the underlying queue allows it
+ *   (one `pop`/`push` plus a check that nobody is already waiting). Otherwise the coroutine is
+ *   parked on an intrusive FIFO of waiters inside the `AsyncQ`.
+ * * When a coroutine on the scheduler makes progress on one side, the waiters of the other
+ *   side are completed right away and put on the ready queue. Progress made by plain threads
+ *   calling `push()`/`pop()` is picked up by the scheduler polling its queues whenever it has
+ *   nothing ready to run, idling with `BackoffWait<>` in between.
+ *
+ * Everything except the wrapped queue itself is touched only by the scheduler thread, so there
+ * are no locks and no atomics beyond the queue's own.
+ *
+ * `run()` returns once every spawned task has finished; tasks that wait forever keep it
+ * running. An exception escaping a task is rethrown from `run()`.
+ *
+ * The scheduler links every unfinished task into an intrusive list, so destroying it frees the
+ * frames of tasks still ready or parked on an `AsyncQ` (e.g. after `run()` threw). Destroy the
+ * scheduler's `AsyncQ`s first; they hold a reference to it anyway.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/wait_strategy.hpp>
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lockedin
+{
+    class CoScheduler;
+
+    /**
+     * @class CoTask
+     * @brief Fire-and-forget coroutine owned by a `CoScheduler` once spawned.
+     */
+    class CoTask
+    {
+    public:
+        struct promise_type
+        {
+            CoScheduler* scheduler{nullptr};
+            promise_type* prev{nullptr}; ///< scheduler's list of unfinished tasks
+            promise_type* next{nullptr};
+
+            CoTask get_return_object() noexcept
+            {
+                return CoTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            auto final_suspend() noexcept;
+
+            void return_void() noexcept
+            {
+            }
+
+            void unhandled_exception() noexcept;
+        };
+
+        CoTask(CoTask&& other) noexcept : handle_{std::exchange(other.handle_, nullptr)}
+        {
+        }
+
+        CoTask& operator=(CoTask&&) = delete;
+        CoTask(const CoTask&) = delete;
+        CoTask& operator=(const CoTask&) = delete;
+
+        ~CoTask()
+        {
+            if (handle_)
+                handle_.destroy(); // never spawned
+        }
+
+    private:
+        friend class CoScheduler;
+
+        explicit CoTask(std::coroutine_handle<promise_type> handle) noexcept : handle_{handle}
+        {
+        }
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief A parked `async_pop`/`async_push`, linked into its queue's waiter list.
+         */
+        struct AsyncWaiter
+        {
+            bool (*attempt)(AsyncWaiter&); ///< retries the operation; true once it completed
+            std::coroutine_handle<> handle;
+            AsyncWaiter* next{nullptr};
+        };
+
+        class AsyncWaitList
+        {
+        public:
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return head_ == nullptr;
+            }
+
+            void append(AsyncWaiter& waiter) noexcept
+            {
+                waiter.next = nullptr;
+                (tail_ != nullptr ? tail_->next : head_) = &waiter;
+                tail_ = &waiter;
+            }
+
+            /**
+             * @brief Completes waiters in FIFO order until one cannot make progress.
+             * @return true if at least one waiter completed.
+             */
+            template <typename Ready> bool complete(Ready&& ready)
+            {
+                bool progressed = false;
+                while (head_ != nullptr && head_->attempt(*head_))
+                {
+                    auto* done = std::exchange(head_, head_->next);
+                    if (head_ == nullptr)
+                        tail_ = nullptr;
+                    ready(done->handle);
+                    progressed = true;
+                }
+                return progressed;
+            }
+
+        private:
+            AsyncWaiter* head_{nullptr};
+            AsyncWaiter* tail_{nullptr};
+        };
+
+        /**
+         * @brief What the scheduler polls when it has nothing ready.
+         */
+        struct AsyncSource
+        {
+            bool (*poll)(AsyncSource&); ///< completes waiters; true if any did
+        };
+    } // namespace detail
+
+    /**
+     * @class CoScheduler
+     * @brief Single-threaded run loop for `CoTask`s and `AsyncQ` waiters.
+     */
+    class CoScheduler
+    {
+    public:
+        CoScheduler() = default;
+        CoScheduler(const CoScheduler&) = delete;
+        CoScheduler& operator=(const CoScheduler&) = delete;
+
+        ~CoScheduler()
+        {
+            // Ready or parked alike: every unfinished task is on the list.
+            while (tasks_ != nullptr)
+            {
+                auto* task = std::exchange(tasks_, tasks_->next);
+                std::coroutine_handle<CoTask::promise_type>::from_promise(*task).destroy();
+            }
+        }
+
+        /**
+         * @brief Takes ownership of `task`; it starts running inside `run()`.
+         */
+        void spawn(CoTask task)
+        {
+            auto handle = std::exchange(task.handle_, nullptr);
+            auto& promise = handle.promise();
+            promise.scheduler = this;
+            promise.next = tasks_;
+            if (tasks_ != nullptr)
+                tasks_->prev = &promise;
+            tasks_ = &promise;
+            ++live_;
+            ready_.push_back(handle);
+        }
+
+        /**
+         * @brief Runs until every spawned task has finished.
+         * @throws whatever the first failing task threw.
+         */
+        void run()
+        {
+            BackoffWait<> wait;
+            while (live_ != 0 && !failure_)
+            {
+                if (!ready_.empty())
+                {
+                    auto handle = ready_.front();
+                    ready_.pop_front();
+                    handle.resume();
+                    wait.reset();
+                    continue;
+                }
+
+                bool progressed = false;
+                for (auto* source : sources_)
+                    progressed |= source->poll(*source);
+                if (!progressed)
+                    wait.idle([] { return false; });
+            }
+            if (failure_)
+                std::rethrow_exception(std::exchange(failure_, nullptr));
+        }
+
+        /**
+         * @brief Number of spawned tasks that have not finished yet.
+         */
+        [[nodiscard]] std::size_t live() const noexcept
+        {
+            return live_;
+        }
+
+        /* ------------------------------------------------------------------
+         * Hooks for awaitables (scheduler thread only)
+         * ----------------------------------------------------------------*/
+
+        void schedule(std::coroutine_handle<> handle)
+        {
+            ready_.push_back(handle);
+        }
+
+        void attach(detail::AsyncSource& source)
+        {
+            sources_.push_back(&source);
+        }
+
+        void detach(detail::AsyncSource& source)
+        {
+            sources_.erase(std::remove(sources_.begin(), sources_.end(), &source),
+                           sources_.end());
+        }
+
+    private:
+        friend struct CoTask::promise_type;
+
+        void finished(std::coroutine_handle<CoTask::promise_type> handle) noexcept
+        {
+            auto& promise = handle.promise();
+            (promise.prev != nullptr ? promise.prev->next : tasks_) = promise.next;
+            if (promise.next != nullptr)
+                promise.next->prev = promise.prev;
+            --live_;
+            handle.destroy();
+        }
+
+        void fail(std::exception_ptr error) noexcept
+        {
+            if (!failure_)
+                failure_ = std::move(error);
+        }
+
+        std::deque<std::coroutine_handle<>> ready_;
+        std::vector<detail::AsyncSource*> sources_;
+        CoTask::promise_type* tasks_{nullptr}; ///< unfinished tasks, owned
+        std::size_t live_{0};
+        std::exception_ptr failure_;
+    };
+
+    inline auto CoTask::promise_type::final_suspend() noexcept
+    {
+        struct Finish
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+            {
+                handle.promise().scheduler->finished(handle);
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+        return Finish{};
+    }
+
+    inline void CoTask::promise_type::unhandled_exception() noexcept
+    {
+        scheduler->fail(std::current_exception());
+    }
+
+    /**
+     * @tparam T     Element type.
+     * @tparam Queue Underlying lockedin queue (`SPSCQ<T>`, `MPSCQ<T>`, ...).
+     *
+     * @class AsyncQ
+     * @brief Queue wrapper adding `co_await`-able push and pop on a `CoScheduler`.
+     */
+    template <typename T, typename Queue> class AsyncQ : private detail::AsyncSource
+    {
+    public:
+        /**
+         * @param scheduler Scheduler whose coroutines await this queue.
+         * @param capacity  Forwarded to the underlying queue.
+         */
+        AsyncQ(CoScheduler& scheduler, std::size_t capacity)
+            : detail::AsyncSource{&AsyncQ::pollWaiters}, scheduler_{scheduler}, queue_(capacity)
+        {
+            scheduler_.attach(*this);
+        }
+
+        AsyncQ(const AsyncQ&) = delete;
+        AsyncQ& operator=(const AsyncQ&) = delete;
+        AsyncQ(AsyncQ&&) = delete;
+        AsyncQ& operator=(AsyncQ&&) = delete;
+
+        ~AsyncQ()
+        {
+            scheduler_.detach(*this);
+        }
+
+        /* ------------------------------------------------------------------
+         * Coroutine API (scheduler thread)
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief `co_await q.async_pop()` yields the next element, suspending while empty.
+         */
+        [[nodiscard]] auto async_pop() noexcept
+        {
+            struct PopAwaiter : detail::AsyncWaiter
+            {
+                AsyncQ* queue;
+                T item{};
+
+                bool await_ready()
+                {
+                    // Waiters keep FIFO order: a newcomer may not overtake a parked consumer.
+                    if (!queue->poppers_.empty() || !queue->queue_.pop(item))
+                        return false;
+                    queue->madeRoom();
+                    return true;
+                }
+
+                void await_suspend(std::coroutine_handle<> h)
+                {
+                    handle = h;
+                    queue->poppers_.append(*this);
+                    queue->pollWaiters(*queue);
+                }
+
+                T await_resume()
+                {
+                    return std::move(item);
+                }
+            };
+
+            PopAwaiter awaiter{};
+            awaiter.attempt = [](detail::AsyncWaiter& w)
+            {
+                auto& self = static_cast<PopAwaiter&>(w);
+                return self.queue->queue_.pop(self.item);
+            };
+            awaiter.queue = this;
+            return awaiter;
+        }
+
+        /**
+         * @brief `co_await q.async_push(v)` enqueues `v`, suspending while full.
+         */
+        [[nodiscard]] auto async_push(T item) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            struct PushAwaiter : detail::AsyncWaiter
+            {
+                AsyncQ* queue;
+                T item;
+
+                bool await_ready()
+                {
+                    if (!queue->pushers_.empty() || !queue->queue_.push(item))
+                        return false;
+                    queue->madeProgress();
+                    return true;
+                }
+
+                void await_suspend(std::coroutine_handle<> h)
+                {
+                    handle = h;
+                    queue->pushers_.append(*this);
+                    queue->pollWaiters(*queue);
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+
+            PushAwaiter awaiter{{}, this, std::move(item)};
+            awaiter.attempt = [](detail::AsyncWaiter& w)
+            {
+                auto& self = static_cast<PushAwaiter&>(w);
+                return self.queue->queue_.push(self.item);
+            };
+            return awaiter;
+        }
+
+        /* ------------------------------------------------------------------
+         * Plain API (any thread the underlying queue allows)
+         * ----------------------------------------------------------------*/
+
+        bool push(const T& item)
+        {
+            return queue_.push(item);
+        }
+
+        bool pop(T& item)
+        {
+            return queue_.pop(item);
+        }
+
+        [[nodiscard]] Queue& queue() noexcept
+        {
+            return queue_;
+        }
+
+    private:
+        // After a coroutine pushed: hand the new element to parked consumers.
+        void madeProgress()
+        {
+            if (!poppers_.empty())
+                pollWaiters(*this);
+        }
+
+        // After a coroutine popped: parked producers may fit now.
+        void madeRoom()
+        {
+            if (!pushers_.empty())
+                pollWaiters(*this);
+        }
+
+        static bool pollWaiters(detail::AsyncSource& source)
+        {
+            auto& self = static_cast<AsyncQ&>(source);
+            const auto ready = [&](std::coroutine_handle<> h) { self.scheduler_.schedule(h); };
+            bool any = false;
+            for (bool progressed = true; progressed;)
+            {
+                progressed = self.poppers_.complete(ready);
+                progressed |= self.pushers_.complete(ready);
+                any |= progressed;
+            }
+            return any;
+        }
+
+        CoScheduler& scheduler_;
+        Queue queue_;
+        detail::AsyncWaitList poppers_;
+        detail::AsyncWaitList pushers_;
+    };
+}
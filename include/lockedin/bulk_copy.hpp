@@ -0,0 +1,114 @@
+/**
+ * @file bulk_copy.hpp
+ * @brief Copy helpers behind the **bulk transfer** paths of the ring buffers.
+ *
+ * Trivially copyable elements are moved in and out of a ring as at most two contiguous
+ * `memcpy`s, split at the wrap point; anything else falls back to element-wise copy/move
+ * assignment. The choice is made at compile time from `std::is_trivially_copyable_v<T>`.
+ *
+ * `BulkStore::Streaming` asks the producer side to write the ring with non-temporal stores
+ * (SSE2 `movntdq`), so that a large batch does not evict the producer's working set from its
+ * cache; the consumer pulls the lines from memory instead of from the producer's L1/L2. It
+ * pays off only for batches that are large compared to the cache, and needs a store fence
+ * before the batch is published because non-temporal stores are weakly ordered. On targets
+ * without SSE2 it degrades to a plain `memcpy`.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace lockedin
+{
+    /**
+     * @brief Store hint for bulk pushes of trivially copyable elements.
+     */
+    enum class BulkStore
+    {
+        Cached,    ///< regular stores (`memcpy`)
+        Streaming, ///< non-temporal stores that bypass the producer's cache
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief `memcpy` with non-temporal stores for the 16-byte-aligned middle of `dst`.
+         */
+        inline void streamCopy(void* dst, const void* src, std::size_t bytes) noexcept
+        {
+#if defined(__SSE2__)
+            auto* d = static_cast<std::byte*>(dst);
+            const auto* s = static_cast<const std::byte*>(src);
+
+            const std::size_t misalignment = reinterpret_cast<std::uintptr_t>(d) & 15;
+            const std::size_t head =
+                misalignment == 0 ? 0 : std::min<std::size_t>(16 - misalignment, bytes);
+            std::memcpy(d, s, head);
+            d += head;
+            s += head;
+            bytes -= head;
+
+            for (; bytes >= 16; bytes -= 16, d += 16, s += 16)
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+            std::memcpy(d, s, bytes);
+#else
+            std::memcpy(dst, src, bytes);
+#endif
+        }
+
+        /**
+         * @brief Orders earlier non-temporal stores before the release store that publishes
+         *        them.
+         */
+        inline void streamFence() noexcept
+        {
+#if defined(__SSE2__)
+            _mm_sfence();
+#endif
+        }
+
+        /**
+         * @brief Copies `count` elements into ring storage.
+         */
+        template <BulkStore Store, typename T>
+        void bulkStore(T* dst, const T* src, std::size_t count)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                if constexpr (Store == BulkStore::Streaming)
+                    streamCopy(dst, src, count * sizeof(T));
+                else
+                    std::memcpy(dst, src, count * sizeof(T));
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    dst[i] = src[i];
+            }
+        }
+
+        /**
+         * @brief Moves `count` elements out of ring storage.
+         */
+        template <typename T> void bulkLoad(T* dst, T* src, std::size_t count)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+                std::memcpy(dst, src, count * sizeof(T));
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    dst[i] = std::move(src[i]);
+            }
+        }
+    } // namespace detail
+}
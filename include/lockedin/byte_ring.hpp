@@ -0,0 +1,185 @@
+/**
+ * @file byte_ring.hpp
+ * @brief Header-only **single-producer / single-consumer byte ring** over a `MirrorBuffer`, for
+ *        variable-length records (length-prefixed messages, wire frames, log lines).
+ *
+ * Because the storage is mapped twice back to back, `prepare(n)` always returns `n` contiguous
+ * writable bytes and `readable()` all unread bytes as one span, even where they cross the end
+ * of the ring. A decoder can parse records straight out of the ring without copying the ones
+ * that wrap.
+ *
+ * ```cpp
+ * ByteRing ring(1 << 20);
+ *
+ * auto out = ring.prepare(sizeof(len) + len);   // producer
+ * encode(out, msg);
+ * ring.commit(out.size());
+ *
+ * auto in = ring.readable();                    // consumer
+ * ring.consume(decodeAll(in));                  // bytes of the complete records
+ * ```
+ *
+ * ## Memory ordering
+ * Positions are monotonic 64-bit byte counts. `commit()` release-stores the write position and
+ * `readable()` acquire-loads it; `consume()` and `prepare()` do the same for the read position.
+ * The producer caches the read position and reloads it only when the cached value says the
+ * ring is full. The consumer loads the write position once per `readable()`, which returns
+ * everything committed so far, so a decoder pays for it once per batch of records.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/mirror_buffer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+namespace lockedin
+{
+    /**
+     * @class ByteRing
+     * @brief Lock-free SPSC byte stream with contiguous reads and writes across the wrap point.
+     */
+    class ByteRing
+    {
+    public:
+        /**
+         * @param capacity Bytes; a power of 2 and a multiple of `MirrorBuffer::pageSize()`.
+         * @throws std::logic_error if capacity is invalid.
+         * @throws std::system_error if the mirror cannot be mapped.
+         */
+        explicit ByteRing(std::size_t capacity) : memory_{checked(capacity)}
+        {
+        }
+
+        ByteRing(const ByteRing&) = delete;
+        ByteRing& operator=(const ByteRing&) = delete;
+        ByteRing(ByteRing&&) = delete;
+        ByteRing& operator=(ByteRing&&) = delete;
+
+        ~ByteRing() = default;
+
+        /* ------------------------------------------------------------------
+         * Producer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief `n` contiguous writable bytes, or an empty span if fewer are free.
+         * Nothing is visible to the consumer until `commit()`.
+         */
+        [[nodiscard]] std::span<std::byte> prepare(std::size_t n)
+        {
+            const auto writePos = writePos_.load(std::memory_order_relaxed);
+            if (writePos + n - cachedRead_ > capacity())
+            {
+                cachedRead_ = readPos_.load(std::memory_order_acquire);
+                if (writePos + n - cachedRead_ > capacity())
+                    return {};
+            }
+            return {memory_.data() + (writePos & (capacity() - 1)), n};
+        }
+
+        /**
+         * @brief Publishes the first `n` bytes of the last `prepare()`.
+         */
+        void commit(std::size_t n) noexcept
+        {
+            writePos_.store(writePos_.load(std::memory_order_relaxed) + n,
+                            std::memory_order_release);
+        }
+
+        /**
+         * @brief Copies `n` bytes in, all or nothing.
+         * @return false if fewer than `n` bytes are free.
+         */
+        bool write(const void* data, std::size_t n)
+        {
+            const auto out = prepare(n);
+            if (out.size() != n)
+                return false;
+            std::memcpy(out.data(), data, n);
+            commit(n);
+            return true;
+        }
+
+        /* ------------------------------------------------------------------
+         * Consumer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Every committed, unconsumed byte as one contiguous span. Valid until
+         *        `consume()`.
+         */
+        [[nodiscard]] std::span<const std::byte> readable()
+        {
+            const auto readPos = readPos_.load(std::memory_order_relaxed);
+            const auto writePos = writePos_.load(std::memory_order_acquire);
+            return {memory_.data() + (readPos & (capacity() - 1)), writePos - readPos};
+        }
+
+        /**
+         * @brief Hands the first `n` bytes of `readable()` back to the producer.
+         */
+        void consume(std::size_t n) noexcept
+        {
+            readPos_.store(readPos_.load(std::memory_order_relaxed) + n,
+                           std::memory_order_release);
+        }
+
+        /**
+         * @brief Copies out and consumes up to `max` bytes.
+         * @return number of bytes read; 0 if the ring is empty.
+         */
+        std::size_t read(void* out, std::size_t max)
+        {
+            const auto in = readable();
+            const auto n = std::min(max, in.size());
+            std::memcpy(out, in.data(), n);
+            consume(n);
+            return n;
+        }
+
+        /* ------------------------------------------------------------------
+         * Status API
+         * ----------------------------------------------------------------*/
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return writePos_.load(std::memory_order_acquire) -
+                   readPos_.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            return memory_.size();
+        }
+
+    private:
+        static std::size_t checked(std::size_t capacity)
+        {
+            if (!std::has_single_bit(capacity) || capacity % MirrorBuffer::pageSize() != 0)
+                throw std::logic_error(
+                    "Capacity must be a power of 2, and a multiple of the page size.");
+            return capacity;
+        }
+
+        MirrorBuffer memory_;
+
+        alignas(detail::cacheline_size) std::atomic<std::uint64_t> readPos_{0};
+
+        alignas(detail::cacheline_size) std::atomic<std::uint64_t> writePos_{0};
+        std::uint64_t cachedRead_{0}; ///< producer only
+    };
+}
@@ -0,0 +1,131 @@
+/**
+ * @file cpu_topology.hpp
+ * @brief Minimal **CPU socket topology** and thread pinning for NUMA-aware placement (Linux).
+ *
+ * `CpuTopology::detect()` groups the CPUs this process may run on by physical package, read
+ * from `/sys/devices/system/cpu/cpu<N>/topology/physical_package_id`. Where that information is
+ * missing (containers, other systems) every allowed CPU ends up on socket 0. A topology can
+ * also be given explicitly, e.g. to emulate several sockets in tests or to carve out a subset
+ * of cores.
+ *
+ * Pinning is best-effort: `pinCurrentThread()` returns false if the kernel refuses the mask
+ * and the thread keeps running where it was.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace lockedin
+{
+    /**
+     * @class CpuTopology
+     * @brief CPU ids grouped by socket; socket indices are dense, starting at 0.
+     */
+    class CpuTopology
+    {
+    public:
+        /**
+         * @param sockets CPU ids of each socket; a CPU may appear in several (emulation).
+         * @throws std::logic_error if there are no sockets or a socket has no CPUs.
+         */
+        explicit CpuTopology(std::vector<std::vector<int>> sockets) : sockets_{std::move(sockets)}
+        {
+            if (sockets_.empty())
+                throw std::logic_error("Topology needs at least one socket.");
+            for (const auto& cpus : sockets_)
+                if (cpus.empty())
+                    throw std::logic_error("Every socket needs at least one CPU.");
+        }
+
+        /**
+         * @brief Sockets of the CPUs in the calling thread's affinity mask.
+         */
+        [[nodiscard]] static CpuTopology detect()
+        {
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+                CPU_SET(0, &allowed);
+
+            std::map<int, std::vector<int>> byPackage;
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (!CPU_ISSET(cpu, &allowed))
+                    continue;
+                const auto path = std::filesystem::path("/sys/devices/system/cpu") /
+                                  ("cpu" + std::to_string(cpu)) / "topology" /
+                                  "physical_package_id";
+                int package = 0;
+                std::ifstream in(path);
+                if (!(in >> package) || package < 0)
+                    package = 0;
+                byPackage[package].push_back(cpu);
+            }
+
+            std::vector<std::vector<int>> sockets;
+            for (auto& [package, cpus] : byPackage)
+                sockets.push_back(std::move(cpus));
+            if (sockets.empty())
+                sockets.push_back({0});
+            return CpuTopology(std::move(sockets));
+        }
+
+        [[nodiscard]] std::size_t sockets() const noexcept
+        {
+            return sockets_.size();
+        }
+
+        [[nodiscard]] const std::vector<int>& cpus(std::size_t socket) const
+        {
+            return sockets_.at(socket);
+        }
+
+        /**
+         * @brief First socket listing `cpu`, or 0 if none does.
+         */
+        [[nodiscard]] std::size_t socketOf(int cpu) const noexcept
+        {
+            for (std::size_t s = 0; s < sockets_.size(); ++s)
+                for (int c : sockets_[s])
+                    if (c == cpu)
+                        return s;
+            return 0;
+        }
+
+        /**
+         * @brief Socket of the CPU the calling thread is running on right now.
+         */
+        [[nodiscard]] std::size_t currentSocket() const noexcept
+        {
+            const int cpu = ::sched_getcpu();
+            return cpu < 0 ? 0 : socketOf(cpu);
+        }
+
+        /**
+         * @brief Restricts the calling thread to the CPUs of `socket`.
+         * @return false if the kernel rejected the mask.
+         */
+        bool pinCurrentThread(std::size_t socket) const
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpus(socket))
+                CPU_SET(cpu, &set);
+            return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+        }
+
+    private:
+        std::vector<std::vector<int>> sockets_;
+    };
+}
@@ -0,0 +1,197 @@
+/**
+ * @file executor.hpp
+ * @brief Fixed-size **message-passing executor** built on `MPSCQ` worker inboxes.
+ *
+ * Each worker owns a bounded `MPSCQ` inbox of `InplaceFunction<void()>` tasks and drains it in
+ * FIFO order; submitters never share a lock and a task never touches the heap. Idle workers
+ * follow the `Wait` policy from `wait_strategy.hpp`, one instance per worker, so that a
+ * submission only notifies the worker it was routed to.
+ *
+ * ## Routing
+ * * `trySubmit()` / `submit()` – round-robin over the workers.
+ * * `trySubmitTo()` / `submitTo()` – pin to a worker; tasks sent to the same worker run in
+ *   submission order (per submitting thread).
+ *
+ * ## Shutdown
+ * `shutdown()` (also run by the destructor) stops the workers after they have drained every
+ * task accepted so far; submitting concurrently with `shutdown()` is not supported. Tasks must
+ * not throw; an escaping exception terminates the process, as it would from any `std::thread`.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/inplace_function.hpp>
+#include <lockedin/mpsc_queue.hpp>
+#include <lockedin/wait_strategy.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lockedin
+{
+    /**
+     * @tparam Wait     Idle policy for the workers (see `wait_strategy.hpp`).
+     * @tparam TaskSize Inline storage for each task's callable, in bytes.
+     *
+     * @class Executor
+     * @brief N workers, each with its own bounded lock-free inbox.
+     */
+    template <typename Wait = BackoffWait<>, std::size_t TaskSize = 64>
+        requires detail::WaitStrategy<Wait>
+    class Executor
+    {
+    public:
+        using task_type = InplaceFunction<void(), TaskSize>;
+
+        /**
+         * @param workers        Number of worker threads (> 0).
+         * @param inboxCapacity  Slots per worker inbox; must be a power of 2.
+         * @throws std::logic_error if `workers` is 0 or the capacity is invalid.
+         */
+        explicit Executor(std::size_t workers, std::size_t inboxCapacity = 1024)
+        {
+            if (workers == 0)
+                throw std::logic_error("Executor needs at least one worker.");
+
+            workers_.reserve(workers);
+            for (std::size_t i = 0; i < workers; ++i)
+                workers_.push_back(std::make_unique<Worker>(inboxCapacity));
+            for (auto& worker : workers_)
+                worker->thread = std::thread([this, w = worker.get()] { run(*w); });
+        }
+
+        Executor(const Executor&) = delete;
+        Executor& operator=(const Executor&) = delete;
+        Executor(Executor&&) = delete;
+        Executor& operator=(Executor&&) = delete;
+
+        ~Executor()
+        {
+            shutdown();
+        }
+
+        /* ------------------------------------------------------------------
+         * Submission API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Routes the task round-robin.
+         * @return false if the chosen worker's inbox is full (the task is dropped).
+         */
+        template <typename F> bool trySubmit(F&& task)
+        {
+            return trySubmitTo(nextWorker(), std::forward<F>(task));
+        }
+
+        /**
+         * @brief Routes the task to `worker`.
+         * @return false if that worker's inbox is full (the task is dropped).
+         */
+        template <typename F> bool trySubmitTo(std::size_t worker, F&& task)
+        {
+            auto& target = *workers_[worker % workers_.size()];
+            if (!target.inbox.push(task_type(std::forward<F>(task))))
+                return false;
+            target.wait.notify();
+            return true;
+        }
+
+        /**
+         * @brief Round-robin submission that yields until an inbox accepts the task.
+         */
+        template <typename F> void submit(F&& task)
+        {
+            submitTo(nextWorker(), std::forward<F>(task));
+        }
+
+        /**
+         * @brief Pinned submission that yields until the worker's inbox accepts the task.
+         */
+        template <typename F> void submitTo(std::size_t worker, F&& task)
+        {
+            auto& target = *workers_[worker % workers_.size()];
+            task_type wrapped(std::forward<F>(task));
+            while (!target.inbox.push(std::move(wrapped)))
+                std::this_thread::yield();
+            target.wait.notify();
+        }
+
+        /* ------------------------------------------------------------------
+         * Lifecycle
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Drains accepted tasks and joins the workers. Idempotent.
+         * @note Must not be called from a worker thread.
+         */
+        void shutdown()
+        {
+            if (stopping_.exchange(true, std::memory_order_acq_rel))
+                return;
+            for (auto& worker : workers_)
+                worker->wait.notify();
+            for (auto& worker : workers_)
+                if (worker->thread.joinable())
+                    worker->thread.join();
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return workers_.size();
+        }
+
+    private:
+        struct Worker
+        {
+            explicit Worker(std::size_t capacity) : inbox(capacity)
+            {
+            }
+
+            MPSCQ<task_type> inbox;
+            alignas(detail::cacheline_size) Wait wait;
+            std::thread thread;
+        };
+
+        void run(Worker& self)
+        {
+            task_type task;
+            const auto ready = [&]
+            { return !self.inbox.empty() || stopping_.load(std::memory_order_acquire); };
+
+            while (!stopping_.load(std::memory_order_acquire))
+            {
+                if (self.inbox.pop(task))
+                {
+                    task();
+                    task.reset();
+                    self.wait.reset();
+                }
+                else
+                {
+                    self.wait.idle(ready);
+                }
+            }
+
+            while (self.inbox.pop(task))
+            {
+                task();
+                task.reset();
+            }
+        }
+
+        std::size_t nextWorker() noexcept
+        {
+            return next_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        alignas(detail::cacheline_size) std::atomic<std::size_t> next_{0};
+        alignas(detail::cacheline_size) std::atomic<bool> stopping_{false};
+    };
+}
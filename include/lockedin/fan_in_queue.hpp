@@ -0,0 +1,382 @@
+/**
+ * @file fan_in_queue.hpp
+ * @brief **Fan-in selector**: N private `SPSCQ` inboxes consumed as one logical MPSC queue.
+ *
+ * Instead of contending on one `MPSCQ` head, every producer owns an `SPSCQ` and the single
+ * consumer chooses which inbox to serve next through a `Merge` policy:
+ *
+ * * `RoundRobinMerge`         – one message per non-empty inbox in turn.
+ * * `WeightedMerge`           – up to `weight[i]` messages from inbox i per visit.
+ * * `TimestampMerge<KeyFn>`   – the inbox whose front message has the smallest key.
+ *
+ * A policy with a `bind(inboxes)` member is handed the inbox count once, by the `FanInQ`
+ * constructor, and may throw there; `select()` runs on every pop and should not check it.
+ *
+ * ## Non-empty summary
+ * A bitmask (one bit per inbox, 64 per word) lets the consumer skip empty inboxes with
+ * `std::countr_zero` instead of touching every producer's cursor line, so a poll that finds
+ * nothing costs one load per summary word. A producer only sets its bit when it finds it clear,
+ * so a busy inbox costs a fence and one relaxed load per push. The consumer clears a bit when
+ * it finds the inbox empty and re-checks the inbox afterwards.
+ *
+ * Producer (publish, fence, check bit) and consumer (clear bit, fence, check inbox) form a
+ * Dekker handshake: with a `seq_cst` fence on both sides at least one of them sees the other's
+ * write, so a non-empty inbox never stays unmarked.
+ *
+ * ## Ordering
+ * Messages from one producer are delivered in push order. There is no order across producers
+ * except what `TimestampMerge` imposes on the messages visible at selection time.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lockedin
+{
+    template <typename T, typename Merge> class FanInQ;
+    template <typename T, typename Merge> class FanInProducer;
+
+    /**
+     * @brief One message per non-empty inbox, cycling through the inboxes.
+     */
+    class RoundRobinMerge
+    {
+    public:
+        template <typename View> std::size_t select(const View& view) noexcept
+        {
+            const auto next = view.nextActive(cursor_);
+            if (next != View::npos)
+                cursor_ = next + 1;
+            return next;
+        }
+
+    private:
+        std::size_t cursor_{0};
+    };
+
+    /**
+     * @brief Serves inbox i for up to `weights[i]` consecutive messages per visit.
+     */
+    class WeightedMerge
+    {
+    public:
+        explicit WeightedMerge(std::vector<std::uint32_t> weights) : weights_{std::move(weights)}
+        {
+        }
+
+        /**
+         * @throws std::logic_error if there are fewer weights than inboxes.
+         */
+        void bind(std::size_t inboxes) const
+        {
+            if (weights_.size() < inboxes)
+                throw std::logic_error("WeightedMerge needs one weight per inbox.");
+        }
+
+        template <typename View> std::size_t select(const View& view) noexcept
+        {
+            if (budget_ > 0 && view.active(current_))
+            {
+                --budget_;
+                return current_;
+            }
+
+            const auto next = view.nextActive(current_ + 1);
+            if (next == View::npos)
+                return next;
+            current_ = next;
+            budget_ = weights_[next] > 0 ? weights_[next] - 1 : 0;
+            return next;
+        }
+
+    private:
+        std::vector<std::uint32_t> weights_;
+        std::size_t current_{std::numeric_limits<std::size_t>::max()};
+        std::uint32_t budget_{0};
+    };
+
+    /**
+     * @tparam KeyFn Callable `key(const T&)` returning an ordered key (e.g. a timestamp).
+     * @brief Serves the inbox whose front message has the smallest key.
+     */
+    template <typename KeyFn> class TimestampMerge
+    {
+    public:
+        explicit TimestampMerge(KeyFn key = {}) : key_{std::move(key)}
+        {
+        }
+
+        template <typename View> std::size_t select(View& view)
+        {
+            auto best = View::npos;
+            std::remove_cvref_t<decltype(std::invoke(key_, *view.peek(0)))> bestKey{};
+            view.forEachActive(
+                [&](std::size_t inbox)
+                {
+                    const auto* front = view.peek(inbox);
+                    if (front == nullptr)
+                        return;
+                    auto key = std::invoke(key_, *front);
+                    if (best == View::npos || key < bestKey)
+                    {
+                        best = inbox;
+                        bestKey = std::move(key);
+                    }
+                });
+            return best;
+        }
+
+    private:
+        KeyFn key_;
+    };
+
+    /**
+     * @tparam T     Element type.
+     * @tparam Merge Selection policy (`RoundRobinMerge`, `WeightedMerge`, `TimestampMerge`).
+     *
+     * @class FanInQ
+     * @brief Single consumer over N single-producer inboxes.
+     */
+    template <typename T, typename Merge = RoundRobinMerge> class FanInQ
+    {
+    public:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * @param producers Number of inboxes (> 0).
+         * @param capacity  Slots per inbox; power of 2, greater than 1.
+         * @throws std::logic_error if `producers` is 0, the capacity is invalid or `merge`
+         *         rejects the inbox count.
+         */
+        explicit FanInQ(std::size_t producers, std::size_t capacity, Merge merge = {})
+            : words_{(producers + 63) / 64}, summary_{std::make_unique<SummaryWord[]>(words_)},
+              merge_{std::move(merge)}
+        {
+            if (producers == 0)
+                throw std::logic_error("FanInQ needs at least one producer.");
+            if constexpr (requires { merge_.bind(producers); })
+                merge_.bind(producers);
+            inboxes_.reserve(producers);
+            for (std::size_t i = 0; i < producers; ++i)
+                inboxes_.push_back(std::make_unique<SPSCQ<T>>(capacity));
+        }
+
+        FanInQ(const FanInQ&) = delete;
+        FanInQ& operator=(const FanInQ&) = delete;
+        FanInQ(FanInQ&&) = delete;
+        FanInQ& operator=(FanInQ&&) = delete;
+
+        ~FanInQ() = default;
+
+        /* ------------------------------------------------------------------
+         * Producer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Handle for producer `index`; at most one thread may use each index.
+         * @throws std::out_of_range if `index` is not a valid inbox.
+         */
+        [[nodiscard]] FanInProducer<T, Merge> getProducer(std::size_t index)
+        {
+            if (index >= inboxes_.size())
+                throw std::out_of_range("FanInQ producer index out of range.");
+            return FanInProducer<T, Merge>(*this, index);
+        }
+
+        /* ------------------------------------------------------------------
+         * Consumer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Dequeues the next message chosen by the merge policy.
+         * @return true if successful, false if every inbox is empty.
+         */
+        bool pop(T& item)
+        {
+            for (auto inbox = merge_.select(*this); inbox != npos; inbox = merge_.select(*this))
+            {
+                if (inboxes_[inbox]->pop(item))
+                    return true;
+                retire(inbox);
+            }
+            return false; // Empty
+        }
+
+        /* ------------------------------------------------------------------
+         * Merge-policy API (consumer thread)
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief First inbox at or after `from` (wrapping) whose summary bit is set, or npos.
+         */
+        [[nodiscard]] std::size_t nextActive(std::size_t from) const noexcept
+        {
+            const auto n = inboxes_.size();
+            from = from >= n ? 0 : from;
+            const auto startWord = from / 64;
+            for (std::size_t w = 0; w <= words_; ++w)
+            {
+                const auto word = (startWord + w) % words_;
+                auto bits = summary_[word].bits.load(std::memory_order_acquire);
+                if (w == 0)
+                    bits &= ~std::uint64_t{0} << (from % 64);
+                else if (w == words_)
+                    bits &= (std::uint64_t{1} << (from % 64)) - 1;
+                if (bits != 0)
+                    return word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+            }
+            return npos;
+        }
+
+        /**
+         * @brief Calls `fn(inbox)` for every inbox whose summary bit is set.
+         */
+        template <typename Fn> void forEachActive(Fn&& fn) const
+        {
+            for (std::size_t word = 0; word < words_; ++word)
+                for (auto bits = summary_[word].bits.load(std::memory_order_acquire); bits != 0;
+                     bits &= bits - 1)
+                    fn(word * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+        }
+
+        [[nodiscard]] bool active(std::size_t inbox) const noexcept
+        {
+            return inbox < inboxes_.size() &&
+                   (summary_[inbox / 64].bits.load(std::memory_order_relaxed) & bitFor(inbox)) != 0;
+        }
+
+        /**
+         * @brief Front message of `inbox` without consuming it, or nullptr if empty.
+         */
+        [[nodiscard]] const T* peek(std::size_t inbox)
+        {
+            return inbox < inboxes_.size() ? inboxes_[inbox]->front() : nullptr;
+        }
+
+        [[nodiscard]] std::size_t inboxes() const noexcept
+        {
+            return inboxes_.size();
+        }
+
+        /* ------------------------------------------------------------------
+         * Status API
+         * ----------------------------------------------------------------*/
+
+        [[nodiscard]] bool empty() const
+        {
+            for (const auto& inbox : inboxes_)
+                if (!inbox->empty())
+                    return false;
+            return true;
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            std::size_t total = 0;
+            for (const auto& inbox : inboxes_)
+                total += inbox->size();
+            return total;
+        }
+
+    private:
+        friend class FanInProducer<T, Merge>;
+
+        struct alignas(detail::cacheline_size) SummaryWord
+        {
+            std::atomic<std::uint64_t> bits{0};
+        };
+
+        static constexpr std::uint64_t bitFor(std::size_t inbox) noexcept
+        {
+            return std::uint64_t{1} << (inbox % 64);
+        }
+
+        // Producer side, after publishing: set our bit only if it looks clear. The fence orders
+        // the publish before the check (pairs with the fence in `retire`).
+        void mark(std::size_t inbox) noexcept
+        {
+            auto& word = summary_[inbox / 64].bits;
+            const auto bit = bitFor(inbox);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if ((word.load(std::memory_order_relaxed) & bit) == 0)
+                word.fetch_or(bit, std::memory_order_release);
+        }
+
+        // Consumer side: inbox looked empty; clear its bit, then close the race with a re-check.
+        void retire(std::size_t inbox) noexcept
+        {
+            auto& word = summary_[inbox / 64].bits;
+            const auto bit = bitFor(inbox);
+            word.fetch_and(~bit, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!inboxes_[inbox]->empty())
+                word.fetch_or(bit, std::memory_order_relaxed);
+        }
+
+        /* ------------------------------------------------------------------
+         * Storage
+         * ----------------------------------------------------------------*/
+        std::vector<std::unique_ptr<SPSCQ<T>>> inboxes_; ///< one ring per producer
+        std::size_t words_;                              ///< summary words (64 inboxes each)
+        std::unique_ptr<SummaryWord[]> summary_;         ///< non-empty hint bitmask
+
+        alignas(detail::cacheline_size) Merge merge_; ///< consumer-owned selection state
+    };
+
+    /**
+     * @class FanInProducer
+     * @brief Push-only handle bound to one inbox of a `FanInQ`.
+     */
+    template <typename T, typename Merge> class FanInProducer
+    {
+    public:
+        /**
+         * @brief Enqueues an item by copy.
+         * @return true if successful, false if this producer's inbox is full.
+         */
+        bool push(const T& item)
+        {
+            if (!queue_->inboxes_[index_]->push(item))
+                return false;
+            queue_->mark(index_);
+            return true;
+        }
+
+        /**
+         * @brief Enqueues an item by move.
+         * @return true if successful, false if this producer's inbox is full.
+         */
+        bool push(T&& item)
+        {
+            if (!queue_->inboxes_[index_]->push(std::move(item)))
+                return false;
+            queue_->mark(index_);
+            return true;
+        }
+
+    private:
+        friend class FanInQ<T, Merge>;
+
+        FanInProducer(FanInQ<T, Merge>& queue, std::size_t index) noexcept
+            : queue_{&queue}, index_{index}
+        {
+        }
+
+        FanInQ<T, Merge>* queue_;
+        std::size_t index_;
+    };
+}
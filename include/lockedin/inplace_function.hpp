@@ -0,0 +1,134 @@
+/**
+ * @file inplace_function.hpp
+ * @brief Type-erased callable with **fixed inline storage** and no heap allocation.
+ *
+ * `InplaceFunction<R(Args...), Capacity>` is the small-buffer-only cousin of `std::function`:
+ * the callable is placement-constructed into an aligned buffer of `Capacity` bytes and a
+ * callable that does not fit is rejected at compile time instead of spilling to the heap.
+ * It is default constructible and nothrow move-assignable, so it can travel through every
+ * lockedin queue by value.
+ *
+ * ## Requirements on the stored callable
+ * * `sizeof(F) <= Capacity` and `alignof(F) <= alignof(std::max_align_t)`.
+ * * Nothrow move constructible (moves happen inside queue slots).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lockedin
+{
+    template <typename Signature, std::size_t Capacity = 64> class InplaceFunction;
+
+    /**
+     * @tparam R        Return type.
+     * @tparam Args     Call arguments.
+     * @tparam Capacity Inline storage in bytes.
+     */
+    template <typename R, typename... Args, std::size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity>
+    {
+    public:
+        InplaceFunction() noexcept = default;
+
+        template <typename F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, InplaceFunction> &&
+                     std::is_invocable_r_v<R, std::remove_cvref_t<F>&, Args...>)
+        InplaceFunction(F&& callable) noexcept(
+            std::is_nothrow_constructible_v<std::remove_cvref_t<F>, F&&>) // NOLINT: implicit
+        {
+            using Fn = std::remove_cvref_t<F>;
+            static_assert(sizeof(Fn) <= Capacity, "Callable does not fit the inline storage.");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                          "Callable is over-aligned for the inline storage.");
+            static_assert(std::is_nothrow_move_constructible_v<Fn>,
+                          "Callable must be nothrow move constructible.");
+
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(callable));
+            ops_ = &opsFor<Fn>;
+        }
+
+        InplaceFunction(const InplaceFunction&) = delete;
+        InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+        InplaceFunction(InplaceFunction&& other) noexcept
+        {
+            moveFrom(other);
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        ~InplaceFunction()
+        {
+            reset();
+        }
+
+        /**
+         * @throws std::bad_function_call if empty.
+         */
+        R operator()(Args... args)
+        {
+            if (ops_ == nullptr)
+                throw std::bad_function_call();
+            return ops_->invoke(storage_, std::forward<Args>(args)...);
+        }
+
+        [[nodiscard]] explicit operator bool() const noexcept
+        {
+            return ops_ != nullptr;
+        }
+
+        void reset() noexcept
+        {
+            if (ops_ != nullptr)
+            {
+                ops_->destroy(storage_);
+                ops_ = nullptr;
+            }
+        }
+
+    private:
+        struct Ops
+        {
+            R (*invoke)(void*, Args&&...);
+            void (*relocate)(void* dst, void* src) noexcept;
+            void (*destroy)(void*) noexcept;
+        };
+
+        template <typename Fn>
+        static constexpr Ops opsFor{
+            [](void* self, Args&&... args) -> R
+            { return std::invoke(*static_cast<Fn*>(self), std::forward<Args>(args)...); },
+            [](void* dst, void* src) noexcept
+            {
+                ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                static_cast<Fn*>(src)->~Fn();
+            },
+            [](void* self) noexcept { static_cast<Fn*>(self)->~Fn(); },
+        };
+
+        void moveFrom(InplaceFunction& other) noexcept
+        {
+            if (other.ops_ == nullptr)
+                return;
+            other.ops_->relocate(storage_, other.storage_);
+            ops_ = std::exchange(other.ops_, nullptr);
+        }
+
+        alignas(std::max_align_t) std::byte storage_[Capacity];
+        const Ops* ops_{nullptr};
+    };
+}
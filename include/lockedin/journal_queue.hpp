@@ -0,0 +1,699 @@
+/**
+ * @file journal_queue.hpp
+ * @brief Header-only **persistent, memory-mapped journal queue** (POSIX).
+ *
+ * `JournalQ` is the durable sibling of `SPSCQ`: the producer appends into a file-backed ring
+ * that never wraps. Instead it rolls over to a new fixed-size *segment* file when the current
+ * one is full. A `JournalReader` tails the same files, live from another thread or process, or
+ * replays them from any sequence after a restart. The journal is the queue: there is no
+ * separate copy into a journaling library and no extra thread on the producer's path.
+ *
+ * ## Layout
+ * `<dir>/<segment index, 20 digits>.journal`; segment k holds sequences
+ * `[k * recordsPerSegment, (k + 1) * recordsPerSegment)`. Each file starts with a 64-byte
+ * header (magic, format, record size, records per segment), followed by fixed-size records
+ * `{stamp, T}`. A record is committed when its stamp equals its sequence + 1. Segments are
+ * created under a temporary name, sized, then renamed (and the directory fsynced), so a reader
+ * never maps a short file.
+ *
+ * ## Rolling over
+ * A background thread keeps the next segment created, mapped and prefaulted
+ * (`MADV_POPULATE_WRITE` where the kernel has it) while the producer fills the current one, and
+ * takes over the segments it rolls away from. A roll is then a hand-off under a mutex once per
+ * segment, with no file creation, page faults or `msync` on the producer's path. The newest file
+ * in the directory may therefore be an empty segment prepared ahead of time.
+ *
+ * ## Memory ordering
+ * * Producer: copies the payload, then `store(release)` on the record's stamp.
+ * * Reader: `load(acquire)` on the stamp it expects next, then copies the payload. Records are
+ *   never rewritten, so no seqlock re-check is needed.
+ *
+ * ## Durability
+ * The `Sync` policy decides when dirty pages are forced to disk with `msync(MS_SYNC)` (which
+ * on Linux has the effect of `fdatasync` for the mapped range): `NoSync` leaves it to the
+ * kernel, `SyncOnRoll` syncs each segment as it is closed (on the background thread),
+ * `SyncEvery<N>` syncs after every N appends. `flush()` forces a sync at any time and waits for
+ * closed segments still being synced. Records appended since the last sync may be lost on
+ * power failure; a process crash loses nothing that `push()` returned for. A failed background
+ * sync is rethrown from the next roll-over or `flush()`.
+ *
+ * On restart the producer reopens the last segment it wrote to and resumes after its last
+ * committed record.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lockedin
+{
+    /**
+     * @brief Never syncs explicitly; the kernel writes pages back on its own schedule.
+     */
+    struct NoSync
+    {
+        static constexpr std::size_t every = 0;
+        static constexpr bool onRoll = false;
+    };
+
+    /**
+     * @brief Syncs a segment when the producer rolls over to the next one.
+     */
+    struct SyncOnRoll
+    {
+        static constexpr std::size_t every = 0;
+        static constexpr bool onRoll = true;
+    };
+
+    /**
+     * @brief Syncs after every `N` appends (and on roll-over).
+     */
+    template <std::size_t N> struct SyncEvery
+    {
+        static_assert(N > 0, "SyncEvery needs N > 0.");
+        static constexpr std::size_t every = N;
+        static constexpr bool onRoll = true;
+    };
+
+    namespace detail
+    {
+        template <typename Sync>
+        concept SyncPolicy = requires {
+            { Sync::every } -> std::convertible_to<std::size_t>;
+            { Sync::onRoll } -> std::convertible_to<bool>;
+        };
+
+        inline constexpr std::uint64_t journal_magic = 0x4C4F434B4A524E4CULL; // "LOCKJRNL"
+        inline constexpr std::uint32_t journal_format = 1;
+
+        struct alignas(64) JournalHeader
+        {
+            std::uint64_t magic;
+            std::uint32_t format;
+            std::uint32_t recordSize;
+            std::uint64_t recordsPerSegment;
+            std::uint64_t firstSequence;
+        };
+
+        template <typename T> struct JournalRecord
+        {
+            alignas(8) std::uint64_t stamp; ///< sequence + 1 once `data` is complete
+            T data;
+        };
+
+        [[noreturn]] inline void throwErrno(const std::string& what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        inline std::filesystem::path segmentPath(const std::filesystem::path& dir,
+                                                 std::uint64_t index)
+        {
+            char name[40];
+            std::snprintf(name, sizeof(name), "%020llu.journal",
+                          static_cast<unsigned long long>(index));
+            return dir / name;
+        }
+
+        /**
+         * @brief Makes a rename or creation inside `dir` durable.
+         */
+        inline void syncDirectory(const std::filesystem::path& dir)
+        {
+            const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+            if (fd < 0)
+                throwErrno("open " + dir.string());
+            const bool ok = ::fsync(fd) == 0;
+            ::close(fd);
+            if (!ok)
+                throwErrno("fsync " + dir.string());
+        }
+
+        /**
+         * @brief RAII mapping of one segment file.
+         */
+        class MappedSegment
+        {
+        public:
+            MappedSegment() = default;
+
+            MappedSegment(const std::filesystem::path& path, bool writable)
+            {
+                const int fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+                if (fd < 0)
+                    throwErrno("open " + path.string());
+                struct stat st = {};
+                if (::fstat(fd, &st) != 0)
+                {
+                    ::close(fd);
+                    throwErrno("fstat " + path.string());
+                }
+                size_ = static_cast<std::size_t>(st.st_size);
+                const int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+                void* base = ::mmap(nullptr, size_, prot, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (base == MAP_FAILED)
+                    throwErrno("mmap " + path.string());
+                base_ = static_cast<std::byte*>(base);
+            }
+
+            MappedSegment(MappedSegment&& other) noexcept
+                : base_{std::exchange(other.base_, nullptr)}, size_{std::exchange(other.size_, 0)}
+            {
+            }
+
+            MappedSegment& operator=(MappedSegment&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    base_ = std::exchange(other.base_, nullptr);
+                    size_ = std::exchange(other.size_, 0);
+                }
+                return *this;
+            }
+
+            MappedSegment(const MappedSegment&) = delete;
+            MappedSegment& operator=(const MappedSegment&) = delete;
+
+            ~MappedSegment()
+            {
+                reset();
+            }
+
+            /**
+             * @brief Faults every page in writable ahead of use; best effort.
+             */
+            void prefault() const noexcept
+            {
+#ifdef MADV_POPULATE_WRITE
+                ::madvise(base_, size_, MADV_POPULATE_WRITE); // Linux 5.14+; EINVAL before
+#endif
+            }
+
+            void reset() noexcept
+            {
+                if (base_ != nullptr)
+                    ::munmap(base_, size_);
+                base_ = nullptr;
+                size_ = 0;
+            }
+
+            /**
+             * @brief Synchronously writes back `[offset, offset + length)`.
+             */
+            void sync(std::size_t offset, std::size_t length) const
+            {
+                static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                const auto begin = offset / page * page;
+                if (length != 0 && ::msync(base_ + begin, offset + length - begin, MS_SYNC) != 0)
+                    throwErrno("msync");
+            }
+
+            [[nodiscard]] std::byte* data() const noexcept
+            {
+                return base_;
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return base_ != nullptr;
+            }
+
+        private:
+            std::byte* base_{nullptr};
+            std::size_t size_{0};
+        };
+    } // namespace detail
+
+    /**
+     * @tparam T    Record type; must be trivially copyable (it is written to disk as bytes).
+     * @tparam Sync Durability policy (`NoSync`, `SyncOnRoll`, `SyncEvery<N>`).
+     *
+     * @class JournalQ
+     * @brief Producer side of a memory-mapped, segmented, append-only queue.
+     */
+    template <typename T, detail::SyncPolicy Sync = SyncOnRoll> class JournalQ
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+
+    public:
+        using record_type = detail::JournalRecord<T>;
+
+        /**
+         * @param dir               Journal directory; created if missing, resumed if not empty.
+         * @param recordsPerSegment Records per segment file; power of 2, greater than 1.
+         * @throws std::logic_error if the segment size is invalid or the directory holds a
+         *         journal with a different record layout.
+         * @throws std::system_error on I/O failure.
+         */
+        explicit JournalQ(std::filesystem::path dir, std::size_t recordsPerSegment = 1 << 16)
+            : dir_{std::move(dir)}, perSegment_{recordsPerSegment}
+        {
+            if (perSegment_ < 2 || (perSegment_ & (perSegment_ - 1)) != 0)
+                throw std::logic_error("Capacity must be a power of 2, and greater than 1.");
+
+            std::filesystem::create_directories(dir_);
+            std::uint64_t last = 0;
+            bool found = false;
+            for (const auto& entry : std::filesystem::directory_iterator(dir_))
+            {
+                if (entry.path().extension() != ".journal")
+                    continue;
+                const auto index = std::stoull(entry.path().stem().string());
+                last = found && last > index ? last : index;
+                found = true;
+            }
+
+            if (found)
+            {
+                resume(last);
+                // The newest file may be a segment prepared ahead that was never written to.
+                if (slot_ == 0 && last > 0 &&
+                    std::filesystem::exists(detail::segmentPath(dir_, last - 1)))
+                    resume(last - 1);
+            }
+            else
+            {
+                segment_ = mapSegment(0);
+            }
+
+            wantedIndex_ = segmentIndex_ + 1;
+            preparedIndex_ = segmentIndex_;
+            roller_ = std::thread([this] { rollerLoop(); });
+        }
+
+        JournalQ(const JournalQ&) = delete;
+        JournalQ& operator=(const JournalQ&) = delete;
+        JournalQ(JournalQ&&) = delete;
+        JournalQ& operator=(JournalQ&&) = delete;
+
+        ~JournalQ()
+        {
+            {
+                std::lock_guard lock(rollMutex_);
+                stopping_ = true;
+            }
+            rollCv_.notify_all();
+            roller_.join();
+
+            if constexpr (Sync::every != 0 || Sync::onRoll)
+            {
+                try
+                {
+                    flush();
+                }
+                catch (...)
+                {
+                }
+            }
+        }
+
+        /* ------------------------------------------------------------------
+         * Producer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Appends a record; rolls over to a new segment when the current one is full.
+         * @return true (the journal is unbounded).
+         * @throws std::system_error if a new segment cannot be created or synced.
+         */
+        bool push(const T& item)
+        {
+            if (slot_ == perSegment_)
+                roll();
+
+            auto& record = records()[slot_];
+            std::memcpy(&record.data, &item, sizeof(T));
+            std::atomic_ref<std::uint64_t>(record.stamp)
+                .store(sequence_ + 1, std::memory_order_release);
+            ++slot_;
+            ++sequence_;
+
+            if constexpr (Sync::every != 0)
+                if (slot_ - syncedSlot_ >= Sync::every)
+                    flush();
+            return true;
+        }
+
+        /**
+         * @brief Forces every record appended so far to disk.
+         * @throws std::system_error if this or an earlier background sync failed.
+         */
+        void flush()
+        {
+            segment_.sync(sizeof(detail::JournalHeader) + syncedSlot_ * sizeof(record_type),
+                          (slot_ - syncedSlot_) * sizeof(record_type));
+            syncedSlot_ = slot_;
+
+            std::unique_lock lock(rollMutex_);
+            rollCv_.wait(lock, [this] { return !retired_ && !syncing_; });
+            rethrowFailure();
+        }
+
+        /**
+         * @brief Deletes whole segments that only hold sequences below `sequence`.
+         */
+        void removeSegmentsBefore(std::uint64_t sequence)
+        {
+            const auto keep = sequence / perSegment_;
+            for (std::uint64_t index = 0; index < keep && index < segmentIndex_; ++index)
+                std::filesystem::remove(detail::segmentPath(dir_, index));
+        }
+
+        /* ------------------------------------------------------------------
+         * Status API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Sequence the next appended record will carry.
+         */
+        [[nodiscard]] std::uint64_t sequence() const noexcept
+        {
+            return sequence_;
+        }
+
+        [[nodiscard]] std::size_t recordsPerSegment() const noexcept
+        {
+            return perSegment_;
+        }
+
+        [[nodiscard]] const std::filesystem::path& directory() const noexcept
+        {
+            return dir_;
+        }
+
+    private:
+        record_type* records() const noexcept
+        {
+            return reinterpret_cast<record_type*>(segment_.data() + sizeof(detail::JournalHeader));
+        }
+
+        // Swaps in the segment the roller prepared and hands it the full one.
+        void roll()
+        {
+            const auto index = segmentIndex_ + 1;
+            detail::MappedSegment next;
+            {
+                std::unique_lock lock(rollMutex_);
+                rollCv_.wait(lock, [&] { return preparedIndex_ == index && !retired_; });
+                rethrowFailure();
+                next = std::move(prepared_);
+                retired_ = std::move(segment_);
+                retiredSlot_ = syncedSlot_;
+                wantedIndex_ = index + 1;
+            }
+            rollCv_.notify_all();
+
+            segment_ = next ? std::move(next) : mapSegment(index); // preparing it failed: retry
+            segmentIndex_ = index;
+            slot_ = 0;
+            syncedSlot_ = 0;
+            sequence_ = index * perSegment_;
+        }
+
+        // Background thread: prepares segment `wantedIndex_`, then syncs and unmaps the segment
+        // the producer rolled away from. Preparing comes first, the producer may be waiting.
+        void rollerLoop()
+        {
+            std::unique_lock lock(rollMutex_);
+            for (;;)
+            {
+                rollCv_.wait(lock, [this]
+                             { return stopping_ || retired_ || preparedIndex_ != wantedIndex_; });
+                if (preparedIndex_ != wantedIndex_)
+                {
+                    const auto index = wantedIndex_;
+                    lock.unlock();
+                    detail::MappedSegment segment;
+                    try
+                    {
+                        segment = mapSegment(index);
+                        segment.prefault();
+                    }
+                    catch (...)
+                    {
+                        // the producer creates it itself and sees the error there
+                    }
+                    lock.lock();
+                    prepared_ = std::move(segment);
+                    preparedIndex_ = index;
+                }
+                else if (retired_)
+                {
+                    auto segment = std::move(retired_);
+                    const auto synced = retiredSlot_;
+                    syncing_ = true;
+                    lock.unlock();
+                    std::exception_ptr failure;
+                    if constexpr (Sync::onRoll)
+                    {
+                        try
+                        {
+                            segment.sync(sizeof(detail::JournalHeader) +
+                                             synced * sizeof(record_type),
+                                         (perSegment_ - synced) * sizeof(record_type));
+                        }
+                        catch (...)
+                        {
+                            failure = std::current_exception();
+                        }
+                    }
+                    segment.reset();
+                    lock.lock();
+                    syncing_ = false;
+                    if (failure)
+                        failure_ = failure;
+                }
+                else
+                {
+                    return; // stopping, with nothing left to do
+                }
+                rollCv_.notify_all();
+            }
+        }
+
+        // Call with `rollMutex_` held.
+        void rethrowFailure()
+        {
+            if (failure_)
+                std::rethrow_exception(std::exchange(failure_, nullptr));
+        }
+
+        // Maps segment `index` writable, creating it unless it was prepared before.
+        detail::MappedSegment mapSegment(std::uint64_t index) const
+        {
+            const auto path = detail::segmentPath(dir_, index);
+            if (!std::filesystem::exists(path))
+                createSegment(path, index);
+            return detail::MappedSegment(path, true);
+        }
+
+        // Re-open segment `index` and skip its committed records.
+        void resume(std::uint64_t index)
+        {
+            segment_ = detail::MappedSegment(detail::segmentPath(dir_, index), true);
+            segmentIndex_ = index;
+            slot_ = 0;
+            sequence_ = index * perSegment_;
+            const auto* header = reinterpret_cast<const detail::JournalHeader*>(segment_.data());
+            if (header->magic != detail::journal_magic ||
+                header->recordSize != sizeof(record_type) ||
+                header->recordsPerSegment != perSegment_)
+                throw std::logic_error("Journal directory holds an incompatible journal.");
+
+            while (slot_ < perSegment_ &&
+                   std::atomic_ref<std::uint64_t>(records()[slot_].stamp)
+                           .load(std::memory_order_acquire) == sequence_ + 1)
+            {
+                ++slot_;
+                ++sequence_;
+            }
+            syncedSlot_ = slot_;
+        }
+
+        void createSegment(const std::filesystem::path& path, std::uint64_t index) const
+        {
+            auto staging = path;
+            staging += ".tmp";
+            const int fd = ::open(staging.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+                detail::throwErrno("open " + staging.string());
+
+            const auto bytes = sizeof(detail::JournalHeader) + perSegment_ * sizeof(record_type);
+            const detail::JournalHeader header{detail::journal_magic, detail::journal_format,
+                                               static_cast<std::uint32_t>(sizeof(record_type)),
+                                               perSegment_, index * perSegment_};
+            const bool ok = ::ftruncate(fd, static_cast<off_t>(bytes)) == 0 &&
+                            ::pwrite(fd, &header, sizeof(header), 0) ==
+                                static_cast<ssize_t>(sizeof(header)) &&
+                            ::fdatasync(fd) == 0;
+            ::close(fd);
+            if (!ok)
+                detail::throwErrno("create " + staging.string());
+            std::filesystem::rename(staging, path); // readers only ever see full-size segments
+            detail::syncDirectory(dir_);            // and so does a restart after power loss
+        }
+
+        std::filesystem::path dir_;
+        std::size_t perSegment_;
+        detail::MappedSegment segment_;
+        std::uint64_t segmentIndex_{0};
+        std::size_t slot_{0};       ///< next record within the segment
+        std::size_t syncedSlot_{0}; ///< records below this are on disk
+        std::uint64_t sequence_{0}; ///< next global sequence
+
+        // Roll-over hand-off with the background thread, guarded by `rollMutex_`
+        std::mutex rollMutex_;
+        std::condition_variable rollCv_;
+        detail::MappedSegment prepared_;  ///< segment `preparedIndex_`, empty if that failed
+        std::uint64_t preparedIndex_{0};  ///< last segment the roller prepared
+        std::uint64_t wantedIndex_{0};    ///< segment the roller should prepare next
+        detail::MappedSegment retired_;   ///< full segment waiting to be synced and unmapped
+        std::size_t retiredSlot_{0};      ///< records of `retired_` already on disk
+        bool syncing_{false};             ///< the roller is syncing a retired segment
+        bool stopping_{false};
+        std::exception_ptr failure_;      ///< background sync error, rethrown by the producer
+        std::thread roller_;              ///< started last, once the members above exist
+    };
+
+    /**
+     * @class JournalReader
+     * @brief Tails or replays a `JournalQ` directory; any thread or process.
+     */
+    template <typename T> class JournalReader
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+
+    public:
+        using record_type = detail::JournalRecord<T>;
+
+        /**
+         * @param dir  Journal directory written by a `JournalQ<T, ...>`.
+         * @param from First sequence to read (e.g. 0 to replay everything retained).
+         */
+        explicit JournalReader(std::filesystem::path dir, std::uint64_t from = 0)
+            : dir_{std::move(dir)}, sequence_{from}
+        {
+        }
+
+        /* ------------------------------------------------------------------
+         * Consumer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Reads the next committed record.
+         * @return true if successful, false if the producer has not appended it yet.
+         * @throws std::logic_error if the journal's record layout does not match `T`.
+         */
+        bool pop(T& item)
+        {
+            if ((!segment_ || slot_ == perSegment_) && !openFor(sequence_))
+                return false; // nothing written yet
+
+            const auto& record = records()[slot_];
+            // Read-only mapping: atomic_ref needs a non-const object, but only loads from it.
+            if (std::atomic_ref<std::uint64_t>(const_cast<std::uint64_t&>(record.stamp))
+                    .load(std::memory_order_acquire) != sequence_ + 1)
+                return false; // empty
+
+            std::memcpy(&item, &record.data, sizeof(T));
+            ++slot_;
+            ++sequence_;
+            return true;
+        }
+
+        /**
+         * @brief Repositions the reader; the next `pop()` returns record `sequence`.
+         */
+        void seek(std::uint64_t sequence) noexcept
+        {
+            sequence_ = sequence;
+            segment_.reset();
+        }
+
+        /**
+         * @brief Sequence of the next record `pop()` will return.
+         */
+        [[nodiscard]] std::uint64_t sequence() const noexcept
+        {
+            return sequence_;
+        }
+
+    private:
+        const record_type* records() const noexcept
+        {
+            return reinterpret_cast<const record_type*>(segment_.data() +
+                                                        sizeof(detail::JournalHeader));
+        }
+
+        // Maps the segment holding `sequence`; false if the producer has not created it yet.
+        bool openFor(std::uint64_t sequence)
+        {
+            if (perSegment_ == 0 && !discoverLayout())
+                return false;
+
+            const auto index = sequence / perSegment_;
+            const auto path = detail::segmentPath(dir_, index);
+            std::error_code ec;
+            if (!std::filesystem::exists(path, ec))
+                return false;
+            segment_ = detail::MappedSegment(path, false);
+            slot_ = static_cast<std::size_t>(sequence % perSegment_);
+            return true;
+        }
+
+        // Reads records-per-segment from any segment header.
+        bool discoverLayout()
+        {
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(dir_, ec))
+            {
+                if (entry.path().extension() != ".journal")
+                    continue;
+                const detail::MappedSegment probe(entry.path(), false);
+                const auto* header = reinterpret_cast<const detail::JournalHeader*>(probe.data());
+                if (header->magic != detail::journal_magic ||
+                    header->recordSize != sizeof(record_type))
+                    throw std::logic_error("Journal record layout does not match T.");
+                perSegment_ = static_cast<std::size_t>(header->recordsPerSegment);
+                return true;
+            }
+            return false;
+        }
+
+        std::filesystem::path dir_;
+        detail::MappedSegment segment_;
+        std::size_t perSegment_{0};
+        std::size_t slot_{0};
+        std::uint64_t sequence_;
+    };
+}
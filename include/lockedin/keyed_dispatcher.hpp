@@ -0,0 +1,383 @@
+/**
+ * @file keyed_dispatcher.hpp
+ * @brief **Key-partitioned fan-out**: one dispatcher routes each message by a key (instrument,
+ *        account, session) to one of N `SPSCQ` worker inboxes, so work runs in parallel while
+ *        the messages of any one key are processed in order, by one worker at a time.
+ *
+ * ```cpp
+ * KeyedDispatcher<Order, decltype(&Order::instrument)> stage(4, 1024, &Order::instrument);
+ *
+ * stage.route(order);                       // dispatcher thread
+ * stage.routeBulk(batch, n);
+ *
+ * auto in = stage.getWorker(w);             // worker thread w
+ * while (in.pop(order)) apply(book[order.instrument], order);
+ * ```
+ *
+ * Keys hash into a fixed number of buckets and every bucket is owned by one worker. Routing is a
+ * hash, a table lookup and an `SPSCQ` push: no CAS and no shared head, unlike feeding a pool
+ * from one `MPSCQ`, and per-key state needs no lock because only the owner touches it.
+ *
+ * ## Bulk routing
+ * Inboxes use `LazyPublish<PublishBatch>`. `route()` publishes its message at once;
+ * `routeBulk()` publishes each touched inbox once per call (or every `PublishBatch` messages),
+ * so a batch costs one cursor store per worker instead of one per message.
+ *
+ * ## Rebalancing hot keys
+ * The dispatcher counts messages per bucket. `rebalance()` moves the hottest buckets of
+ * overloaded workers to the least loaded ones, greedily, while that narrows the gap between
+ * them. A bucket that carries a single dominant key cannot be split; it stays where it is.
+ *
+ * A move must not let the new owner run ahead of messages still queued at, or being processed
+ * by, the old one. While a move is pending the bucket's new messages are refused, exactly as if
+ * an inbox were full (`route()` returns false, `routeBulk()` stops before them), so the old
+ * owner's backlog for the bucket stops growing; once the old owner has finished the bucket's
+ * last message, the next one goes to the new owner. The move thus completes however busy the
+ * old owner stays with other buckets. A worker counts its previous message as finished when it
+ * calls `pop()`/`popBulk()` again, so processing must be done before asking for more.
+ *
+ * ## Memory ordering
+ * Workers release-store how many messages they have finished; the dispatcher acquire-loads that
+ * count before switching a bucket, then publishes to the new owner through its inbox. The new
+ * owner therefore sees everything the old owner did for the key.
+ *
+ * ## Threads
+ * `route()`, `routeBulk()`, `rebalance()` and `owner()` belong to the single dispatcher thread;
+ * each `KeyedWorker` to one worker thread.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lockedin
+{
+    template <typename T, typename KeyFn, typename Hash> class KeyedDispatcher;
+
+    namespace detail
+    {
+        template <typename T, typename KeyFn>
+        using key_of_t = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>;
+
+        inline constexpr std::size_t keyed_publish_batch = 16;
+
+        template <typename T> struct KeyedInbox
+        {
+            explicit KeyedInbox(std::size_t capacity) : queue{capacity}
+            {
+            }
+
+            SPSCQ<T, NoStats, LazyPublish<keyed_publish_batch>> queue;
+            alignas(cacheline_size) std::atomic<std::uint64_t> finished{0};
+            std::uint64_t popped{0}; ///< worker only
+        };
+    }
+
+    /**
+     * @class KeyedWorker
+     * @brief Consumer handle of one worker inbox; use from one thread only.
+     */
+    template <typename T> class KeyedWorker
+    {
+    public:
+        /**
+         * @brief Finishes the previous message and dequeues the next one.
+         * @return true if successful, false if the inbox is empty.
+         */
+        bool pop(T& item)
+        {
+            finish();
+            if (!inbox_->queue.pop(item))
+                return false;
+            ++inbox_->popped;
+            return true;
+        }
+
+        /**
+         * @brief Finishes the previous messages and dequeues up to `max` more.
+         * @return number of items dequeued; 0 if the inbox is empty.
+         */
+        std::size_t popBulk(T* out, std::size_t max)
+        {
+            finish();
+            const auto n = inbox_->queue.popBulk(out, max);
+            inbox_->popped += n;
+            return n;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return inbox_->queue.empty();
+        }
+
+    private:
+        template <typename, typename, typename> friend class KeyedDispatcher;
+
+        explicit KeyedWorker(detail::KeyedInbox<T>& inbox) : inbox_{&inbox}
+        {
+        }
+
+        void finish() noexcept
+        {
+            if (inbox_->finished.load(std::memory_order_relaxed) != inbox_->popped)
+                inbox_->finished.store(inbox_->popped, std::memory_order_release);
+        }
+
+        detail::KeyedInbox<T>* inbox_;
+    };
+
+    /**
+     * @tparam T     Message type.
+     * @tparam KeyFn Callable `key(const T&)` returning the partitioning key.
+     * @tparam Hash  Hash of the key; the result is mixed before picking a bucket.
+     *
+     * @class KeyedDispatcher
+     * @brief One router, N ordered-per-key worker inboxes.
+     */
+    template <typename T, typename KeyFn, typename Hash = std::hash<detail::key_of_t<T, KeyFn>>>
+    class KeyedDispatcher
+    {
+    public:
+        static constexpr std::size_t PublishBatch = detail::keyed_publish_batch;
+
+        /**
+         * @param workers  Number of worker inboxes (> 0).
+         * @param capacity Slots per inbox; power of 2, greater than `PublishBatch`.
+         * @param key      Key extractor.
+         * @param buckets  Routing granularity; a power of 2, at least `workers`. More buckets
+         *                 let `rebalance()` separate more keys.
+         * @throws std::logic_error if `workers`, `capacity` or `buckets` is invalid.
+         */
+        KeyedDispatcher(std::size_t workers, std::size_t capacity, KeyFn key = {},
+                        std::size_t buckets = 1024, Hash hash = {})
+            : key_{std::move(key)}, hash_{std::move(hash)}, buckets_(buckets),
+              shift_{64 - std::countr_zero(buckets)}, pushed_(workers, 0)
+        {
+            if (workers == 0)
+                throw std::logic_error("KeyedDispatcher needs at least one worker.");
+            if (!std::has_single_bit(buckets) || buckets < workers)
+                throw std::logic_error("Buckets must be a power of 2, and at least the workers.");
+            inboxes_.reserve(workers);
+            for (std::size_t w = 0; w < workers; ++w)
+                inboxes_.push_back(std::make_unique<detail::KeyedInbox<T>>(capacity));
+            for (std::size_t b = 0; b < buckets; ++b)
+                buckets_[b].owner = buckets_[b].target = static_cast<std::uint32_t>(b % workers);
+        }
+
+        KeyedDispatcher(const KeyedDispatcher&) = delete;
+        KeyedDispatcher& operator=(const KeyedDispatcher&) = delete;
+        KeyedDispatcher(KeyedDispatcher&&) = delete;
+        KeyedDispatcher& operator=(KeyedDispatcher&&) = delete;
+
+        ~KeyedDispatcher() = default;
+
+        /* ------------------------------------------------------------------
+         * Dispatcher API (single thread)
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Routes one message to the owner of its key.
+         * @return true if successful, false if that worker's inbox is full or the key's bucket
+         *         is being moved (retry later, as for a full inbox).
+         */
+        bool route(const T& item)
+        {
+            const auto w = enqueue(item);
+            if (w == npos)
+                return false;
+            inboxes_[w]->queue.flush();
+            return true;
+        }
+
+        /**
+         * @brief Routes `items[0, count)` in order, stopping at the first message that `route()`
+         *        would refuse; publishes each touched inbox once.
+         * @return number of messages routed (a prefix of `items`).
+         */
+        std::size_t routeBulk(const T* items, std::size_t count)
+        {
+            std::size_t n = 0;
+            for (; n < count && enqueue(items[n]) != npos; ++n)
+            {
+            }
+            for (auto& inbox : inboxes_)
+                inbox->queue.flush();
+            return n;
+        }
+
+        /**
+         * @brief Moves hot buckets from overloaded to underloaded workers.
+         * @param tolerance A worker is overloaded above `(1 + tolerance)` times the mean load.
+         * @return number of buckets reassigned.
+         *
+         * Load is the number of messages routed since the previous call, halved at each call so
+         * that older traffic still counts a little. Moves take effect as described above.
+         */
+        std::size_t rebalance(double tolerance = 0.25)
+        {
+            std::vector<std::uint64_t> load(inboxes_.size(), 0);
+            std::uint64_t total = 0;
+            for (const auto& bucket : buckets_)
+            {
+                load[bucket.target] += bucket.hits;
+                total += bucket.hits;
+            }
+            const double limit =
+                (1.0 + tolerance) * static_cast<double>(total) / static_cast<double>(load.size());
+
+            std::size_t moved = 0;
+            for (std::size_t round = 0; round < buckets_.size(); ++round)
+            {
+                const auto hot = static_cast<std::size_t>(
+                    std::max_element(load.begin(), load.end()) - load.begin());
+                const auto cold = static_cast<std::size_t>(
+                    std::min_element(load.begin(), load.end()) - load.begin());
+                if (static_cast<double>(load[hot]) <= limit)
+                    break;
+
+                // The hottest bucket whose move still lowers the maximum of the pair.
+                Bucket* pick = nullptr;
+                for (auto& bucket : buckets_)
+                    if (bucket.target == hot && bucket.hits != 0 &&
+                        bucket.hits < load[hot] - load[cold] &&
+                        (pick == nullptr || bucket.hits > pick->hits))
+                        pick = &bucket;
+                if (pick == nullptr)
+                    break; // what is left on `hot` cannot be split
+
+                pick->target = static_cast<std::uint32_t>(cold);
+                load[hot] -= pick->hits;
+                load[cold] += pick->hits;
+                ++moved;
+            }
+
+            for (auto& bucket : buckets_)
+            {
+                bucket.hits /= 2;
+                settle(bucket);
+            }
+            moves_ += moved;
+            return moved;
+        }
+
+        /**
+         * @brief Worker that currently receives messages with key `key`.
+         */
+        [[nodiscard]] std::size_t owner(const detail::key_of_t<T, KeyFn>& key)
+        {
+            auto& bucket = buckets_[this->bucket(key)];
+            settle(bucket);
+            return bucket.owner;
+        }
+
+        /* ------------------------------------------------------------------
+         * Worker API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Handle for worker `index`; at most one thread may use each index.
+         * @throws std::out_of_range if `index` is not a valid worker.
+         */
+        [[nodiscard]] KeyedWorker<T> getWorker(std::size_t index)
+        {
+            if (index >= inboxes_.size())
+                throw std::out_of_range("KeyedDispatcher worker index out of range.");
+            return KeyedWorker<T>(*inboxes_[index]);
+        }
+
+        /* ------------------------------------------------------------------
+         * Status API
+         * ----------------------------------------------------------------*/
+
+        [[nodiscard]] std::size_t workers() const noexcept
+        {
+            return inboxes_.size();
+        }
+
+        [[nodiscard]] std::size_t buckets() const noexcept
+        {
+            return buckets_.size();
+        }
+
+        /**
+         * @brief Bucket of `key`; keys in one bucket always share a worker.
+         */
+        [[nodiscard]] std::size_t bucket(const detail::key_of_t<T, KeyFn>& key) const
+        {
+            // Fibonacci hashing: spreads identity hashes of small integer ids over the buckets.
+            const auto h = static_cast<std::uint64_t>(std::invoke(hash_, key));
+            if (shift_ == 64)
+                return 0;
+            return static_cast<std::size_t>((h * 0x9E3779B97F4A7C15ULL) >> shift_);
+        }
+
+        /**
+         * @brief Bucket reassignments made by `rebalance()` so far (dispatcher thread).
+         */
+        [[nodiscard]] std::uint64_t moves() const noexcept
+        {
+            return moves_;
+        }
+
+    private:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        struct Bucket
+        {
+            std::uint32_t owner;   ///< worker receiving the bucket's messages
+            std::uint32_t target;  ///< owner after a pending move
+            std::uint64_t last{0}; ///< owner's push count after the bucket's last message;
+                                   ///< frozen while a move is pending
+            std::uint64_t hits{0}; ///< messages since the last decay
+        };
+
+        // Completes a pending move once the old owner has finished the bucket's messages.
+        // @return false while the move is still pending.
+        bool settle(Bucket& bucket) noexcept
+        {
+            if (bucket.owner == bucket.target)
+                return true;
+            if (inboxes_[bucket.owner]->finished.load(std::memory_order_acquire) < bucket.last)
+                return false;
+            bucket.owner = bucket.target;
+            bucket.last = 0; // nothing of the bucket is queued at the new owner yet
+            return true;
+        }
+
+        // Pushes without publishing; returns the worker, or npos if its inbox is full or the
+        // bucket is mid-move.
+        std::size_t enqueue(const T& item)
+        {
+            auto& bucket = buckets_[this->bucket(std::invoke(key_, item))];
+            if (!settle(bucket))
+                return npos; // feeding the old owner would keep the move from ever completing
+            const auto w = bucket.owner;
+            if (!inboxes_[w]->queue.push(item))
+                return npos;
+            bucket.last = ++pushed_[w];
+            ++bucket.hits;
+            return w;
+        }
+
+        [[no_unique_address]] KeyFn key_;
+        [[no_unique_address]] Hash hash_;
+        std::vector<Bucket> buckets_;
+        int shift_;
+        std::vector<std::uint64_t> pushed_; ///< per worker, dispatcher only
+        std::uint64_t moves_{0};
+        std::vector<std::unique_ptr<detail::KeyedInbox<T>>> inboxes_;
+    };
+}
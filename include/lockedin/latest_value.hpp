@@ -0,0 +1,231 @@
+/**
+ * @file latest_value.hpp
+ * @brief **Latest-value exchange**: a wait-free triple buffer and a seqlock-protected cell for
+ *        consumers that only ever need the newest snapshot (risk limits, top of book, ...).
+ *
+ * Unlike a queue, nothing is ever "full" and intermediate values are simply overwritten.
+ *
+ * | Primitive      | Writers | Readers | Writer    | Reader                       |
+ * |----------------|---------|---------|-----------|------------------------------|
+ * | `TripleBuffer` | 1       | 1       | wait-free | wait-free, reads in place    |
+ * | `SeqLockCell`  | 1       | any     | wait-free | lock-free, copies, may retry |
+ *
+ * ## TripleBuffer
+ * Three cache-line-aligned buffers: the writer owns one (*back*), the reader owns one (*front*)
+ * and the third (*middle*) is exchanged through a single atomic byte holding its index plus a
+ * *fresh* bit. `publish()` swaps back and middle and sets the bit; `update()` swaps middle and
+ * front if the bit is set. Each side does one atomic exchange, never waits, and the reader can
+ * use its front buffer in place for as long as it likes.
+ *
+ * ## SeqLockCell
+ * The writer makes the sequence odd, writes the value and makes it even again; readers copy the
+ * value and retry if the sequence was odd or changed meanwhile. Readers never write shared
+ * memory, so any number of them scale, but `T` must be trivially copyable because a reader may
+ * copy a torn value before discarding it.
+ *
+ * ## Memory ordering
+ * * TripleBuffer: `acq_rel` exchanges hand buffer contents from writer to reader.
+ * * SeqLockCell: the same protocol as `SPMCQEntry` — store odd sequence, release fence, write
+ *   data, release-store even sequence; readers acquire-load, copy, acquire fence, re-check.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/wait_strategy.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace lockedin
+{
+    /**
+     * @tparam T Value type; must be default constructible.
+     *
+     * @class TripleBuffer
+     * @brief Wait-free single-writer / single-reader latest-value exchange.
+     */
+    template <typename T> class TripleBuffer
+    {
+    public:
+        TripleBuffer() = default;
+
+        /**
+         * @param initial Value seen by the reader until the first `publish()`.
+         */
+        explicit TripleBuffer(const T& initial)
+        {
+            for (auto& buffer : buffers_)
+                buffer.value = initial;
+        }
+
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+        TripleBuffer(TripleBuffer&&) = delete;
+        TripleBuffer& operator=(TripleBuffer&&) = delete;
+
+        ~TripleBuffer() = default;
+
+        /* ------------------------------------------------------------------
+         * Writer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Buffer the writer may fill in place before calling `publish()`.
+         */
+        [[nodiscard]] T& writeBuffer() noexcept
+        {
+            return buffers_[back_].value;
+        }
+
+        /**
+         * @brief Makes the write buffer the newest value and takes a fresh one to write into.
+         */
+        void publish() noexcept
+        {
+            const auto published = static_cast<std::uint8_t>(back_ | fresh);
+            const auto previous = middle_.exchange(published, std::memory_order_acq_rel);
+            back_ = previous & index;
+        }
+
+        /**
+         * @brief Copies `value` into the write buffer and publishes it.
+         */
+        void publish(const T& value)
+        {
+            writeBuffer() = value;
+            publish();
+        }
+
+        /* ------------------------------------------------------------------
+         * Reader API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Switches to the newest published value, if there is one.
+         * @return true if the front buffer changed.
+         */
+        bool update() noexcept
+        {
+            if ((middle_.load(std::memory_order_relaxed) & fresh) == 0)
+                return false;
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & index;
+            return true;
+        }
+
+        /**
+         * @brief Newest value; stays valid and unchanged until the next `read()` or `update()`.
+         */
+        [[nodiscard]] const T& read() noexcept
+        {
+            update();
+            return buffers_[front_].value;
+        }
+
+        /**
+         * @brief true if a value was published since the reader last switched buffers.
+         */
+        [[nodiscard]] bool pending() const noexcept
+        {
+            return (middle_.load(std::memory_order_relaxed) & fresh) != 0;
+        }
+
+    private:
+        static constexpr std::uint8_t index = 0b011;
+        static constexpr std::uint8_t fresh = 0b100;
+
+        struct alignas(detail::cacheline_size) Buffer
+        {
+            T value{};
+        };
+
+        Buffer buffers_[3];
+        alignas(detail::cacheline_size) std::uint8_t back_{0}; ///< writer only
+        alignas(detail::cacheline_size) std::atomic<std::uint8_t> middle_{1};
+        alignas(detail::cacheline_size) std::uint8_t front_{2}; ///< reader only
+    };
+
+    /**
+     * @tparam T Value type; must be trivially copyable.
+     *
+     * @class SeqLockCell
+     * @brief Single-writer / multi-reader latest-value cell protected by a sequence lock.
+     */
+    template <typename T> class SeqLockCell
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "SeqLockCell requires a trivially copyable T");
+
+    public:
+        SeqLockCell() = default;
+
+        explicit SeqLockCell(const T& initial) : value_{initial}
+        {
+        }
+
+        SeqLockCell(const SeqLockCell&) = delete;
+        SeqLockCell& operator=(const SeqLockCell&) = delete;
+        SeqLockCell(SeqLockCell&&) = delete;
+        SeqLockCell& operator=(SeqLockCell&&) = delete;
+
+        ~SeqLockCell() = default;
+
+        /* ------------------------------------------------------------------
+         * Writer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Replaces the value. Writer thread only.
+         */
+        void store(const T& value) noexcept
+        {
+            const auto seq = sequence_.load(std::memory_order_relaxed);
+            sequence_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            value_ = value;
+            sequence_.store(seq + 2, std::memory_order_release);
+        }
+
+        /* ------------------------------------------------------------------
+         * Reader API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief One attempt to copy the value.
+         * @return false if it raced with the writer; `out` is then unspecified.
+         */
+        bool tryLoad(T& out) const noexcept
+        {
+            const auto before = sequence_.load(std::memory_order_acquire);
+            if (before & 1)
+                return false;
+            out = value_;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return sequence_.load(std::memory_order_relaxed) == before;
+        }
+
+        /**
+         * @brief Copies a consistent value, retrying while the writer is active.
+         */
+        [[nodiscard]] T load() const noexcept
+        {
+            T out;
+            while (!tryLoad(out))
+                detail::cpu_relax();
+            return out;
+        }
+
+        /**
+         * @brief Number of `store()` calls so far; lets readers detect a new value cheaply.
+         */
+        [[nodiscard]] std::uint64_t version() const noexcept
+        {
+            return sequence_.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        alignas(detail::cacheline_size) std::atomic<std::uint64_t> sequence_{0};
+        T value_{};
+    };
+}
@@ -0,0 +1,183 @@
+/**
+ * @file mirror_buffer.hpp
+ * @brief **Double-mapped ring storage**: the same pages mapped twice, back to back, so that
+ *        every range `[i, i + n)` with `i < size` and `n <= size` is contiguous in virtual
+ *        memory (Linux).
+ *
+ * ```text
+ *   virtual:  | page 0 .. page k-1 | page 0 .. page k-1 |
+ *               ^ base               ^ base + size (same physical pages)
+ * ```
+ *
+ * A record that wraps around the end of a ring can then be read or written through a single
+ * pointer, so bulk copies need no split at the wrap point and variable-length decoders no
+ * special case for it.
+ *
+ * * `MirrorBuffer` owns the mapping: a `memfd_create` file mapped twice into a reserved
+ *   `2 * size` region.
+ * * `MirrorStorage` plugs it into `SPSCQ` (`SPSCQ<T, NoStats, EagerPublish, MirrorStorage>`);
+ *   `pushBulk()`/`popBulk()` then copy in one piece and `readable()` exposes every queued item
+ *   as one span.
+ * * `ByteRing` (see `byte_ring.hpp`) is a single-producer / single-consumer byte stream on top
+ *   of it.
+ *
+ * ## Constraints
+ * The mirrored size must be a whole number of pages, so `capacity * sizeof(T)` must be a
+ * multiple of the page size (e.g. 4096 slots of 8 bytes, or 64 slots of 64 bytes). Elements
+ * must be trivially copyable: slot `i` and slot `i + capacity` are the same object seen at two
+ * addresses.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace lockedin
+{
+    /**
+     * @class MirrorBuffer
+     * @brief `size` bytes of shared memory mapped at `data()` and again at `data() + size`.
+     */
+    class MirrorBuffer
+    {
+    public:
+        /**
+         * @param size Bytes to mirror; must be a non-zero multiple of `pageSize()`.
+         * @throws std::logic_error if the size is invalid.
+         * @throws std::system_error if the memory cannot be created or mapped.
+         */
+        explicit MirrorBuffer(std::size_t size) : size_{size}
+        {
+            if (size == 0 || size % pageSize() != 0)
+                throw std::logic_error("Mirror size must be a non-zero multiple of the page size.");
+
+            const int fd = ::memfd_create("lockedin-mirror", MFD_CLOEXEC);
+            if (fd < 0)
+                throw std::system_error(errno, std::generic_category(), "memfd_create");
+            if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+                fail(fd, nullptr, "ftruncate");
+
+            // Reserve both halves first so nothing else can land in the second one.
+            void* reserved = ::mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS,
+                                    -1, 0);
+            if (reserved == MAP_FAILED)
+                fail(fd, nullptr, "mmap");
+            auto* base = static_cast<std::byte*>(reserved);
+
+            for (std::byte* half : {base, base + size})
+            {
+                if (::mmap(half, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) ==
+                    MAP_FAILED)
+                    fail(fd, base, "mmap");
+            }
+            ::close(fd);
+            base_ = base;
+        }
+
+        MirrorBuffer(MirrorBuffer&& other) noexcept
+            : base_{std::exchange(other.base_, nullptr)}, size_{std::exchange(other.size_, 0)}
+        {
+        }
+
+        MirrorBuffer& operator=(MirrorBuffer&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                base_ = std::exchange(other.base_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        MirrorBuffer(const MirrorBuffer&) = delete;
+        MirrorBuffer& operator=(const MirrorBuffer&) = delete;
+
+        ~MirrorBuffer()
+        {
+            reset();
+        }
+
+        /**
+         * @brief Start of the mapping; valid for `2 * size()` bytes.
+         */
+        [[nodiscard]] std::byte* data() const noexcept
+        {
+            return base_;
+        }
+
+        /**
+         * @brief Bytes of distinct memory (half of the mapped range).
+         */
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        [[nodiscard]] static std::size_t pageSize() noexcept
+        {
+            static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return page;
+        }
+
+    private:
+        void reset() noexcept
+        {
+            if (base_ != nullptr)
+                ::munmap(base_, 2 * size_);
+            base_ = nullptr;
+        }
+
+        [[noreturn]] void fail(int fd, std::byte* reserved, const char* what)
+        {
+            const int error = errno;
+            if (reserved != nullptr)
+                ::munmap(reserved, 2 * size_);
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), what);
+        }
+
+        std::byte* base_{nullptr};
+        std::size_t size_;
+    };
+
+    /**
+     * @brief `SPSCQ` storage policy backed by a `MirrorBuffer`.
+     */
+    struct MirrorStorage
+    {
+        static constexpr bool contiguous = true;
+
+        template <typename T> class buffer
+        {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "MirrorStorage requires a trivially copyable T");
+
+        public:
+            /**
+             * @throws std::logic_error if `capacity * sizeof(T)` is not a multiple of the page
+             *         size.
+             */
+            explicit buffer(std::size_t capacity) : memory_{capacity * sizeof(T)}
+            {
+            }
+
+            [[nodiscard]] T* data() const noexcept
+            {
+                return reinterpret_cast<T*>(memory_.data());
+            }
+
+        private:
+            MirrorBuffer memory_;
+        };
+    };
+}
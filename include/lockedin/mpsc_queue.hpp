@@ -1,6 +1,7 @@
 #pragma once
 
 #include <lockedin/abstract_queue.hpp>
+#include <lockedin/queue_stats.hpp>
 
 #include <atomic>
 #include <cstddef>
@@ -13,11 +14,14 @@
 
 namespace lockedin
 {
-    template <typename T> class MPSCQ : public AbstractQ<T, MPSCQ<T>>
+    // Stats: telemetry policy (see queue_stats.hpp). Producer counters are shared by all
+    // producers and live on the head_ line they already contend for.
+    template <typename T, detail::StatsPolicy Stats = NoStats>
+    class MPSCQ : public AbstractQ<T, MPSCQ<T, Stats>>
     {
     public:
         explicit MPSCQ(std::size_t capacity)
-            : AbstractQ<T, MPSCQ<T>>(capacity), capacity_{capacity}, mask_{capacity_ - 1},
+            : AbstractQ<T, MPSCQ<T, Stats>>(capacity), capacity_{capacity}, mask_{capacity_ - 1},
               buffer_{std::make_unique<Cell[]>(capacity_)}
         {
             if (capacity_ < 2 || (capacity_ & (capacity_ - 1)) != 0)
@@ -70,6 +74,16 @@ namespace lockedin
             return head - tail;
         }
 
+        // Snapshot of the telemetry counters; safe to call from any thread.
+        [[nodiscard]] QueueStatsSnapshot stats() const noexcept
+            requires Stats::enabled
+        {
+            QueueStatsSnapshot snapshot;
+            producerStats_.collect(snapshot);
+            consumerStats_.collect(snapshot);
+            return snapshot;
+        }
+
     private:
         struct Cell
         {
@@ -82,8 +96,10 @@ namespace lockedin
         std::unique_ptr<Cell[]> buffer_;
 
         alignas(detail::cacheline_size) std::atomic<std::size_t> head_{0};
+        [[no_unique_address]] typename Stats::template producer_side<true> producerStats_;
 
         alignas(detail::cacheline_size) std::atomic<std::size_t> tail_{0};
+        [[no_unique_address]] typename Stats::consumer_side consumerStats_;
 
         template <typename U> bool emplace_impl(U&& value)
         {
@@ -105,9 +121,11 @@ namespace lockedin
                     {
                         break;
                     }
+                    producerStats_.onCasRetry();
                 }
                 else if (diff < 0)
                 {
+                    producerStats_.onFull();
                     return false;
                 }
                 else
@@ -118,6 +136,12 @@ namespace lockedin
 
             cell->value = std::forward<U>(value);
             cell->sequence.store(pos + 1, std::memory_order_release);
+            producerStats_.onPush(
+                [&]
+                {
+                    const auto tail = tail_.load(std::memory_order_relaxed);
+                    return tail > pos + 1 ? 0 : pos + 1 - tail;
+                });
             return true;
         }
 
@@ -131,11 +155,15 @@ namespace lockedin
                 static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
 
             if (diff < 0)
+            {
+                consumerStats_.onEmpty();
                 return false;
+            }
 
             out = std::move(cell->value);
             cell->sequence.store(pos + capacity_, std::memory_order_release);
             tail_.store(pos + 1, std::memory_order_relaxed);
+            consumerStats_.onPop();
             return true;
         }
     };
@@ -0,0 +1,246 @@
+/**
+ * @file notifying_queue.hpp
+ * @brief **Event-loop integration**: wakes a consumer blocked in epoll/io_uring through an
+ *        `eventfd` when its queue goes from empty to non-empty (Linux).
+ *
+ * A consumer that also serves sockets cannot spin on `pop()`. `NotifyingQ` wraps any lockedin
+ * queue and a `Notifier` (an `eventfd` by default) whose descriptor the consumer adds to its
+ * event loop:
+ *
+ * ```cpp
+ * NotifyingQ<Order> q(1024);                  // MPSCQ<Order> + EventFdNotifier
+ * epoll_ctl(ep, EPOLL_CTL_ADD, q.fd(), &ev);  // EPOLLIN
+ * for (;;) {
+ *     while (q.pop(order)) handle(order);
+ *     if (q.arm() && epoll_wait(ep, ...) > 0) // sleeps only if still empty
+ *         q.clear();                          // readable: consume the eventfd counter
+ * }
+ * ```
+ *
+ * ## Coalescing
+ * The consumer sets an atomic *armed* flag just before it goes to sleep. A producer only pays
+ * for the `write(2)` if it is the one that flips the flag back, so one wake is issued per sleep
+ * no matter how many producers push in the meantime, and none at all while the consumer is
+ * busy draining.
+ *
+ * ## Memory ordering
+ * Classic store/load (Dekker) handshake: the consumer stores `armed` then re-checks the queue,
+ * the producer publishes its element then loads `armed`, both separated by a seq_cst fence.
+ * Either the consumer sees the element and does not sleep, or the producer sees the flag and
+ * wakes it. The producer-side fence is the only cost on the fast path when nobody sleeps.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/mpsc_queue.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace lockedin
+{
+    /**
+     * @brief Non-blocking `eventfd`; readable while at least one wake is pending.
+     */
+    class EventFdNotifier
+    {
+    public:
+        /**
+         * @throws std::system_error if the descriptor cannot be created.
+         */
+        EventFdNotifier() : fd_{::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)}
+        {
+            if (fd_ < 0)
+                throw std::system_error(errno, std::generic_category(), "eventfd");
+        }
+
+        EventFdNotifier(const EventFdNotifier&) = delete;
+        EventFdNotifier& operator=(const EventFdNotifier&) = delete;
+
+        ~EventFdNotifier()
+        {
+            ::close(fd_);
+        }
+
+        /**
+         * @brief Makes the descriptor readable.
+         */
+        void notify() noexcept
+        {
+            const std::uint64_t one = 1;
+            [[maybe_unused]] const auto written = ::write(fd_, &one, sizeof(one));
+        }
+
+        /**
+         * @brief Consumes pending wakes so the descriptor stops being readable.
+         */
+        void clear() noexcept
+        {
+            std::uint64_t count = 0;
+            [[maybe_unused]] const auto read = ::read(fd_, &count, sizeof(count));
+        }
+
+        [[nodiscard]] int fd() const noexcept
+        {
+            return fd_;
+        }
+
+    private:
+        int fd_;
+    };
+
+    namespace detail
+    {
+        template <typename N>
+        concept Notifier = requires(N& notifier, const N& constNotifier) {
+            notifier.notify();
+            notifier.clear();
+            { constNotifier.fd() } -> std::convertible_to<int>;
+        };
+    } // namespace detail
+
+    /**
+     * @tparam T        Element type.
+     * @tparam Queue    Underlying lockedin queue (`MPSCQ<T>` by default, `SPSCQ<T>`, ...).
+     * @tparam Notifier Wake mechanism (`EventFdNotifier`).
+     *
+     * @class NotifyingQ
+     * @brief Queue wrapper that wakes a sleeping consumer through a file descriptor.
+     */
+    template <typename T, typename Queue = MPSCQ<T>, typename Notifier = EventFdNotifier>
+        requires detail::Notifier<Notifier>
+    class NotifyingQ
+    {
+    public:
+        /**
+         * @param capacity Forwarded to the underlying queue.
+         */
+        explicit NotifyingQ(std::size_t capacity) : queue_(capacity)
+        {
+        }
+
+        NotifyingQ(const NotifyingQ&) = delete;
+        NotifyingQ& operator=(const NotifyingQ&) = delete;
+        NotifyingQ(NotifyingQ&&) = delete;
+        NotifyingQ& operator=(NotifyingQ&&) = delete;
+
+        ~NotifyingQ() = default;
+
+        /* ------------------------------------------------------------------
+         * Producer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Enqueues an item by copy, waking the consumer if it is asleep.
+         * @return true if successful, false if the queue is full.
+         */
+        bool push(const T& item)
+        {
+            if (!queue_.push(item))
+                return false;
+            wake();
+            return true;
+        }
+
+        /**
+         * @brief Enqueues an item by move, waking the consumer if it is asleep.
+         * @return true if successful, false if the queue is full.
+         */
+        bool push(T&& item)
+        {
+            if (!queue_.push(std::move(item)))
+                return false;
+            wake();
+            return true;
+        }
+
+        /* ------------------------------------------------------------------
+         * Consumer API
+         * ----------------------------------------------------------------*/
+
+        bool pop(T& item)
+        {
+            return queue_.pop(item);
+        }
+
+        /**
+         * @brief Announces that the consumer is about to wait on `fd()`.
+         * @return true if the consumer may sleep, false if elements arrived meanwhile (drain
+         *         them first).
+         */
+        bool arm() noexcept
+        {
+            armed_.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // `armed` before the re-check
+            if (queue_.empty())
+                return true;
+            armed_.store(false, std::memory_order_relaxed); // a racing producer may still wake us
+            return false;
+        }
+
+        /**
+         * @brief Consumes the wake once the event loop reported `fd()` readable; one `read(2)`.
+         */
+        void clear() noexcept
+        {
+            notifier_.clear();
+        }
+
+        /**
+         * @brief Descriptor to register (readable) with epoll / io_uring.
+         */
+        [[nodiscard]] int fd() const noexcept
+        {
+            return notifier_.fd();
+        }
+
+        /* ------------------------------------------------------------------
+         * Status API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Producer-side `write(2)` calls issued so far; the consumer adds one `read(2)`
+         *        per `clear()` and its own wait calls.
+         */
+        [[nodiscard]] std::uint64_t wakeups() const noexcept
+        {
+            return wakeups_.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return queue_.empty();
+        }
+
+        [[nodiscard]] Queue& queue() noexcept
+        {
+            return queue_;
+        }
+
+    private:
+        void wake() noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst); // element before `armed`
+            if (armed_.load(std::memory_order_relaxed) &&
+                armed_.exchange(false, std::memory_order_acq_rel))
+            {
+                wakeups_.fetch_add(1, std::memory_order_relaxed);
+                notifier_.notify();
+            }
+        }
+
+        Queue queue_;
+        Notifier notifier_;
+        alignas(detail::cacheline_size) std::atomic<bool> armed_{false};
+        alignas(detail::cacheline_size) std::atomic<std::uint64_t> wakeups_{0};
+    };
+}
@@ -0,0 +1,323 @@
+/**
+ * @file object_pool.hpp
+ * @brief Header-only **lock-free fixed-size object pool** and `PooledPtr<T>`, an owning
+ *        pointer cheap enough to pass through any lockedin queue instead of a large `T`.
+ *
+ * ```cpp
+ * ObjectPool<Snapshot> pool(4096);
+ * SPSCQ<PooledPtr<Snapshot>> q(1024);
+ *
+ * auto alloc = pool.getAllocator();      // producer thread: private free list
+ * q.push(alloc.make(args...));           // construct in place, hand over 16 bytes
+ *
+ * PooledPtr<Snapshot> s;                 // consumer thread
+ * q.pop(s);
+ * s.reset();                             // slot goes back to the pool
+ * ```
+ *
+ * ## Cross-thread free
+ * The pool is tuned for the pipeline pattern where one thread allocates and another frees.
+ * Slots are released onto a shared Treiber stack with a single CAS push. A `PoolAllocator`
+ * never pops individual slots from it: when its private free list runs dry it takes the whole
+ * stack with one `exchange`, keeps the first `PoolAllocator::RefillBatch` slots and swaps the
+ * rest back in with a second `exchange`. Allocation costs two atomics per *batch*, several
+ * allocating threads share the pool instead of the first one to run dry hoarding it, and the
+ * stack is free of the ABA problem (nobody ever pops a single node). Slots freed between the
+ * two exchanges (or handed back by another refill) are pushed back behind the rest.
+ *
+ * ## Complexity
+ * * `PoolAllocator::make()` – *O(1)* amortised; a refill walks at most `RefillBatch` slots,
+ *   plus whatever reached the stack while it ran.
+ * * `PooledPtr::reset()`    – *O(1)* / lock-free (CAS push).
+ *
+ * ## Memory ordering
+ * Releasing a slot is a release CAS on the stack head, taking the stack an acquire exchange,
+ * so the destructor's writes happen-before the slot is handed out again.
+ *
+ * Slots are padded to a cache line, so an object being filled by the producer never shares a
+ * line with one the consumer is still reading. The pool must outlive every `PoolAllocator` and
+ * `PooledPtr` obtained from it.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace lockedin
+{
+    template <typename T> class ObjectPool;
+    template <typename T> class PoolAllocator;
+
+    namespace detail
+    {
+        template <typename T> struct alignas(std::max(alignof(T), cacheline_size)) PoolSlot
+        {
+            union
+            {
+                PoolSlot* next; ///< while free
+                alignas(T) std::byte storage[sizeof(T)];
+            };
+
+            T* object() noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(storage));
+            }
+
+            static PoolSlot* of(T* object) noexcept
+            {
+                return reinterpret_cast<PoolSlot*>(reinterpret_cast<std::byte*>(object));
+            }
+        };
+    } // namespace detail
+
+    /**
+     * @class PooledPtr
+     * @brief Move-only owner of an object from an `ObjectPool`; destroying it returns the slot.
+     */
+    template <typename T> class PooledPtr
+    {
+    public:
+        PooledPtr() noexcept = default;
+
+        PooledPtr(PooledPtr&& other) noexcept
+            : object_{std::exchange(other.object_, nullptr)}, pool_{other.pool_}
+        {
+        }
+
+        PooledPtr& operator=(PooledPtr&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                object_ = std::exchange(other.object_, nullptr);
+                pool_ = other.pool_;
+            }
+            return *this;
+        }
+
+        PooledPtr(const PooledPtr&) = delete;
+        PooledPtr& operator=(const PooledPtr&) = delete;
+
+        ~PooledPtr()
+        {
+            reset();
+        }
+
+        /**
+         * @brief Destroys the object and releases its slot. May run on any thread.
+         */
+        void reset() noexcept
+        {
+            if (object_ != nullptr)
+                pool_->destroy(std::exchange(object_, nullptr));
+        }
+
+        [[nodiscard]] T* get() const noexcept
+        {
+            return object_;
+        }
+
+        T& operator*() const noexcept
+        {
+            return *object_;
+        }
+
+        T* operator->() const noexcept
+        {
+            return object_;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return object_ != nullptr;
+        }
+
+    private:
+        friend class PoolAllocator<T>;
+
+        PooledPtr(T* object, ObjectPool<T>* pool) noexcept : object_{object}, pool_{pool}
+        {
+        }
+
+        T* object_{nullptr};
+        ObjectPool<T>* pool_{nullptr};
+    };
+
+    /**
+     * @tparam T Pooled object type.
+     *
+     * @class ObjectPool
+     * @brief Fixed set of cache-line-padded slots for `T`, allocated once at construction.
+     */
+    template <typename T> class ObjectPool
+    {
+        using Slot = detail::PoolSlot<T>;
+
+    public:
+        /**
+         * @param capacity Number of objects that can be alive at the same time.
+         * @throws std::logic_error if capacity is 0.
+         */
+        explicit ObjectPool(std::size_t capacity)
+            : capacity_{capacity}, slots_{std::make_unique<Slot[]>(capacity)}
+        {
+            if (capacity_ == 0)
+                throw std::logic_error("Pool capacity must be greater than 0.");
+
+            for (std::size_t i = 0; i + 1 < capacity_; ++i)
+                slots_[i].next = &slots_[i + 1];
+            slots_[capacity_ - 1].next = nullptr;
+            free_.store(&slots_[0], std::memory_order_relaxed);
+        }
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+        ObjectPool(ObjectPool&&) = delete;
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        ~ObjectPool() = default;
+
+        /**
+         * @brief Per-thread allocation handle. One per allocating thread.
+         */
+        [[nodiscard]] PoolAllocator<T> getAllocator() noexcept
+        {
+            return PoolAllocator<T>(*this);
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+    private:
+        friend class PoolAllocator<T>;
+        friend class PooledPtr<T>;
+
+        void destroy(T* object) noexcept
+        {
+            object->~T();
+            auto* slot = Slot::of(object);
+            release(slot, slot);
+        }
+
+        // Pushes the chain first..last (linked through `next`) onto the shared stack.
+        void release(Slot* first, Slot* last) noexcept
+        {
+            Slot* head = free_.load(std::memory_order_relaxed);
+            do
+            {
+                last->next = head;
+            } while (!free_.compare_exchange_weak(head, first, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+        }
+
+        // Takes up to `max` slots off the shared stack and hands the remainder back.
+        Slot* take(std::size_t max) noexcept
+        {
+            if (free_.load(std::memory_order_relaxed) == nullptr)
+                return nullptr;
+            Slot* first = free_.exchange(nullptr, std::memory_order_acquire);
+            if (first == nullptr)
+                return nullptr;
+
+            Slot* last = first;
+            for (std::size_t n = 1; n < max && last->next != nullptr; ++n)
+                last = last->next;
+            if (last->next == nullptr)
+                return first;
+
+            Slot* raced = free_.exchange(std::exchange(last->next, nullptr),
+                                         std::memory_order_acq_rel);
+            if (raced != nullptr)
+            {
+                Slot* tail = raced;
+                while (tail->next != nullptr)
+                    tail = tail->next;
+                release(raced, tail);
+            }
+            return first;
+        }
+
+        const std::size_t capacity_;
+        std::unique_ptr<Slot[]> slots_;
+        alignas(detail::cacheline_size) std::atomic<Slot*> free_{nullptr};
+    };
+
+    /**
+     * @class PoolAllocator
+     * @brief Thread-private cache of free slots; created by `ObjectPool::getAllocator()`.
+     *
+     * Not thread-safe: each allocating thread owns its own. Remaining cached slots go back to
+     * the pool when the allocator is destroyed.
+     */
+    template <typename T> class PoolAllocator
+    {
+        using Slot = detail::PoolSlot<T>;
+
+    public:
+        static constexpr std::size_t RefillBatch = 64; ///< slots taken per refill
+
+        PoolAllocator(PoolAllocator&& other) noexcept
+            : pool_{other.pool_}, cache_{std::exchange(other.cache_, nullptr)}
+        {
+        }
+
+        PoolAllocator& operator=(PoolAllocator&&) = delete;
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+        ~PoolAllocator()
+        {
+            if (cache_ == nullptr)
+                return;
+            Slot* last = cache_;
+            while (last->next != nullptr)
+                last = last->next;
+            pool_->release(cache_, last);
+        }
+
+        /**
+         * @brief Constructs a `T` in a free slot.
+         * @return the owning pointer, or an empty one if every slot is in use.
+         */
+        template <typename... Args> [[nodiscard]] PooledPtr<T> make(Args&&... args)
+        {
+            if (cache_ == nullptr && (cache_ = pool_->take(RefillBatch)) == nullptr)
+                return {};
+
+            Slot* slot = cache_;
+            cache_ = slot->next;
+            try
+            {
+                T* object =
+                    ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+                return PooledPtr<T>(object, pool_);
+            }
+            catch (...)
+            {
+                slot->next = cache_;
+                cache_ = slot;
+                throw;
+            }
+        }
+
+    private:
+        friend class ObjectPool<T>;
+
+        explicit PoolAllocator(ObjectPool<T>& pool) noexcept : pool_{&pool}
+        {
+        }
+
+        ObjectPool<T>* pool_;
+        Slot* cache_{nullptr};
+    };
+}
@@ -0,0 +1,205 @@
+/**
+ * @file priority_queue.hpp
+ * @brief Header-only **bounded multi-producer / single-consumer priority queue** built from a
+ *        fixed set of `MPSCQ` lanes.
+ *
+ * Lane 0 is the most urgent (cancels), higher lanes less so (new orders, heartbeats, ...).
+ * Every lane is an independent `MPSCQ<T>` ring, so order is FIFO *within* a lane and producers
+ * on different lanes never contend on the same ring.
+ *
+ * A 64-bit *occupancy* mask has bit `i` set while lane `i` may hold elements. The consumer finds
+ * the most urgent non-empty lane with a single `std::countr_zero` and pops from it: *O(1)*
+ * regardless of the number of lanes or elements.
+ *
+ * ## Starvation avoidance
+ * With `starvationLimit == 0` priorities are strict and a flooded lane 0 starves the others.
+ * With `starvationLimit == n`, after `n` consecutive pops from the top lane while less urgent
+ * lanes were waiting, the next pop is served from one of those lanes, chosen round-robin, so
+ * every occupied lane is served at least once every `n * (Lanes - 1)` pops.
+ *
+ * ## Memory ordering
+ * * Producer: push into the lane, seq_cst fence, set the lane bit if it is not already set.
+ * * Consumer: when a lane turns out empty it clears the bit, issues a seq_cst fence and
+ *   re-checks the lane, restoring the bit if an element slipped in. Together this is a Dekker
+ *   handshake: a bit is never left cleared while its lane holds a published element.
+ * * A push that has not reached the fence yet may not be visible to `pop()`, exactly like an
+ *   in-flight `MPSCQ::push`.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/mpsc_queue.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace lockedin
+{
+    /**
+     * @tparam T     Element type.
+     * @tparam Lanes Number of priority levels, 1 to 64; lane 0 is popped first.
+     *
+     * @class PriorityMPSCQ
+     * @brief K-lane priority queue for many producers and one consumer.
+     */
+    template <typename T, std::size_t Lanes = 4> class PriorityMPSCQ
+    {
+        static_assert(Lanes >= 1 && Lanes <= 64, "PriorityMPSCQ supports 1 to 64 lanes");
+
+        using Lane = MPSCQ<T>;
+
+    public:
+        /**
+         * @param capacity        Capacity of each lane (power of 2, greater than 1).
+         * @param starvationLimit Consecutive top-lane pops before a waiting lane is served; 0
+         *                        for strict priority.
+         * @throws std::logic_error if capacity is invalid.
+         */
+        explicit PriorityMPSCQ(std::size_t capacity, std::size_t starvationLimit = 0)
+            : starvationLimit_{starvationLimit}
+        {
+            for (auto& lane : lanes_)
+                lane = std::make_unique<Lane>(capacity);
+        }
+
+        PriorityMPSCQ(const PriorityMPSCQ&) = delete;
+        PriorityMPSCQ& operator=(const PriorityMPSCQ&) = delete;
+        PriorityMPSCQ(PriorityMPSCQ&&) = delete;
+        PriorityMPSCQ& operator=(PriorityMPSCQ&&) = delete;
+
+        ~PriorityMPSCQ() = default;
+
+        /* ------------------------------------------------------------------
+         * Producer API (any thread)
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Enqueues an item by copy on `lane` (must be below `Lanes`).
+         * @return true if successful, false if that lane is full.
+         */
+        bool push(const T& item, std::size_t lane)
+        {
+            assert(lane < Lanes && "lane out of range");
+            if (!lanes_[lane]->push(item))
+                return false;
+            markOccupied(lane);
+            return true;
+        }
+
+        /**
+         * @brief Enqueues an item by move on `lane` (must be below `Lanes`).
+         * @return true if successful, false if that lane is full.
+         */
+        bool push(T&& item, std::size_t lane)
+        {
+            assert(lane < Lanes && "lane out of range");
+            if (!lanes_[lane]->push(std::move(item)))
+                return false;
+            markOccupied(lane);
+            return true;
+        }
+
+        /* ------------------------------------------------------------------
+         * Consumer API (single thread)
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Dequeues from the most urgent non-empty lane.
+         * @return true if successful, false if every lane is empty.
+         */
+        bool pop(T& item)
+        {
+            std::size_t lane = 0;
+            return pop(item, lane);
+        }
+
+        /**
+         * @brief Dequeues like `pop(item)` and reports the lane the item came from.
+         */
+        bool pop(T& item, std::size_t& lane)
+        {
+            std::uint64_t mask = occupancy_.load(std::memory_order_acquire);
+            while (mask != 0)
+            {
+                lane = pick(mask);
+                if (lanes_[lane]->pop(item))
+                    return true;
+
+                // Lane drained (or its next push is still in flight): clear its bit, then
+                // restore it if an element slipped in, and move on to the next lane.
+                const std::uint64_t bit = std::uint64_t{1} << lane;
+                occupancy_.fetch_and(~bit, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!lanes_[lane]->empty())
+                    occupancy_.fetch_or(bit, std::memory_order_relaxed);
+                mask &= ~bit;
+            }
+            return false;
+        }
+
+        /* ------------------------------------------------------------------
+         * Status API
+         * ----------------------------------------------------------------*/
+
+        [[nodiscard]] bool empty() const
+        {
+            return occupancy_.load(std::memory_order_acquire) == 0;
+        }
+
+        [[nodiscard]] static constexpr std::size_t lanes() noexcept
+        {
+            return Lanes;
+        }
+
+        [[nodiscard]] Lane& lane(std::size_t index) noexcept
+        {
+            return *lanes_[index];
+        }
+
+    private:
+        void markOccupied(std::size_t lane)
+        {
+            const std::uint64_t bit = std::uint64_t{1} << lane;
+            std::atomic_thread_fence(std::memory_order_seq_cst); // element before the mask
+            if ((occupancy_.load(std::memory_order_relaxed) & bit) == 0)
+                occupancy_.fetch_or(bit, std::memory_order_release);
+        }
+
+        // Most urgent lane, unless the waiting lanes are owed a turn.
+        std::size_t pick(std::uint64_t mask) noexcept
+        {
+            const auto top = static_cast<std::size_t>(std::countr_zero(mask));
+            const std::uint64_t waiting = mask & (mask - 1);
+            if (starvationLimit_ == 0 || waiting == 0)
+            {
+                streak_ = 0;
+                return top;
+            }
+            if (++streak_ <= starvationLimit_)
+                return top;
+
+            streak_ = 0;
+            const std::uint64_t ahead =
+                cursor_ < 64 ? waiting & (~std::uint64_t{0} << cursor_) : 0;
+            const auto lane =
+                static_cast<std::size_t>(std::countr_zero(ahead != 0 ? ahead : waiting));
+            cursor_ = lane + 1;
+            return lane;
+        }
+
+        std::array<std::unique_ptr<Lane>, Lanes> lanes_;
+        alignas(detail::cacheline_size) std::atomic<std::uint64_t> occupancy_{0};
+
+        // Consumer only.
+        alignas(detail::cacheline_size) std::size_t starvationLimit_;
+        std::size_t streak_{0};
+        std::size_t cursor_{0};
+    };
+}
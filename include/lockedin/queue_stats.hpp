@@ -0,0 +1,287 @@
+/**
+ * @file queue_stats.hpp
+ * @brief Opt-in, compile-time selectable **telemetry policies** for the lockedin queues.
+ *
+ * Every queue takes a `Stats` policy as a template parameter. The default, `NoStats`, is a set
+ * of empty types whose hooks are no-ops; queues store them with `[[no_unique_address]]`, so a
+ * queue without telemetry has exactly the layout and code of one that never heard of it.
+ *
+ * `QueueStats<SampleEvery>` keeps per-side counters next to the cursor that side already owns:
+ *
+ * * Producer side – pushes, full hits, sampled occupancy and the sampled high-water mark, on the
+ *   producer cursor's cache line.
+ * * Consumer side – pops, empty hits and overruns (SPMC only), on the consumer cursor's line.
+ *
+ * Counters are written by their owning thread only, with a relaxed load followed by a relaxed
+ * store (a plain `mov` on x86, no locked RMW). They are still `std::atomic`, so any other thread
+ * may read a `QueueStatsSnapshot` at any time without a data race and without touching the
+ * hot path. Multi-producer sides (MPSC) select `SharedWriters`, which falls back to relaxed
+ * `fetch_add` on a line the producers are already contending for.
+ *
+ * MPSCQ additionally counts `casRetries`, the claims of the head cursor that lost a CAS to
+ * another producer; `casRetries / pushes` is the producer contention rate.
+ *
+ * Occupancy is sampled once every `SampleEvery` pushes (a power of 2) so that queues which
+ * have to load the opposite cursor to compute it only pay for that on sampled pushes.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lockedin
+{
+    /**
+     * @brief Point-in-time copy of a queue's counters, safe to take from any thread.
+     * @note Fields are loaded individually, so the snapshot is not a consistent cut; each
+     *       counter is monotonic and at most a few operations stale.
+     */
+    struct QueueStatsSnapshot
+    {
+        std::uint64_t pushes{0};           ///< successful pushes
+        std::uint64_t fullHits{0};         ///< pushes rejected because the queue was full
+        std::uint64_t pops{0};             ///< successful pops
+        std::uint64_t emptyHits{0};        ///< pops that found the queue empty
+        std::uint64_t overruns{0};         ///< consumer lapped by the producer (SPMC)
+        std::uint64_t casRetries{0};       ///< head claims lost to another producer (MPSC)
+        std::uint64_t highWater{0};        ///< largest sampled occupancy
+        std::uint64_t occupancySum{0};     ///< sum of sampled occupancies
+        std::uint64_t occupancySamples{0}; ///< number of occupancy samples
+
+        [[nodiscard]] double meanOccupancy() const noexcept
+        {
+            return occupancySamples == 0
+                       ? 0.0
+                       : static_cast<double>(occupancySum) / static_cast<double>(occupancySamples);
+        }
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Counter with a single writer: load + store instead of a locked RMW.
+         */
+        class StatCounter
+        {
+        public:
+            StatCounter() = default;
+
+            // Handles that carry their own counters (SPMC consumers) are copyable.
+            StatCounter(const StatCounter& other) noexcept : value_{other.load()}
+            {
+            }
+
+            StatCounter& operator=(const StatCounter& other) noexcept
+            {
+                value_.store(other.load(), std::memory_order_relaxed);
+                return *this;
+            }
+
+            std::uint64_t add(std::uint64_t n = 1) noexcept
+            {
+                const auto prev = value_.load(std::memory_order_relaxed);
+                value_.store(prev + n, std::memory_order_relaxed);
+                return prev;
+            }
+
+            void raise(std::uint64_t candidate) noexcept
+            {
+                if (candidate > value_.load(std::memory_order_relaxed))
+                    value_.store(candidate, std::memory_order_relaxed);
+            }
+
+            [[nodiscard]] std::uint64_t load() const noexcept
+            {
+                return value_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<std::uint64_t> value_{0};
+        };
+
+        /**
+         * @brief Counter written by several threads (MPSC producers).
+         */
+        class SharedStatCounter
+        {
+        public:
+            std::uint64_t add(std::uint64_t n = 1) noexcept
+            {
+                return value_.fetch_add(n, std::memory_order_relaxed);
+            }
+
+            void raise(std::uint64_t candidate) noexcept
+            {
+                auto current = value_.load(std::memory_order_relaxed);
+                while (candidate > current &&
+                       !value_.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+                {
+                }
+            }
+
+            [[nodiscard]] std::uint64_t load() const noexcept
+            {
+                return value_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<std::uint64_t> value_{0};
+        };
+    } // namespace detail
+
+    /**
+     * @brief Default policy: every hook is an empty inline function on an empty type.
+     */
+    struct NoStats
+    {
+        static constexpr bool enabled = false;
+
+        template <bool SharedWriters = false> struct producer_side
+        {
+            template <typename Occupancy>
+            constexpr void onPush(Occupancy&&, std::size_t = 1) noexcept
+            {
+            }
+
+            constexpr void onFull() noexcept
+            {
+            }
+
+            constexpr void onCasRetry() noexcept
+            {
+            }
+
+            constexpr void collect(QueueStatsSnapshot&) const noexcept
+            {
+            }
+        };
+
+        struct consumer_side
+        {
+            constexpr void onPop(std::size_t = 1) noexcept
+            {
+            }
+
+            constexpr void onEmpty() noexcept
+            {
+            }
+
+            constexpr void onOverrun() noexcept
+            {
+            }
+
+            constexpr void collect(QueueStatsSnapshot&) const noexcept
+            {
+            }
+        };
+    };
+
+    /**
+     * @tparam SampleEvery Occupancy is sampled on every `SampleEvery`-th push (power of 2).
+     */
+    template <std::size_t SampleEvery = 64> struct QueueStats
+    {
+        static_assert(SampleEvery != 0 && (SampleEvery & (SampleEvery - 1)) == 0,
+                      "SampleEvery must be a power of 2.");
+
+        static constexpr bool enabled = true;
+
+        template <bool SharedWriters = false> struct producer_side
+        {
+            using counter =
+                std::conditional_t<SharedWriters, detail::SharedStatCounter, detail::StatCounter>;
+
+            /**
+             * @param occupancy Callable returning the occupancy after the push; only invoked
+             *                  on sampled pushes.
+             * @param n         Elements pushed at once (bulk pushes); sampled if the batch
+             *                  covers a multiple of `SampleEvery`.
+             */
+            template <typename Occupancy>
+            void onPush(Occupancy&& occupancy, std::size_t n = 1) noexcept
+            {
+                const auto phase = pushes.add(n) & (SampleEvery - 1);
+                if (phase != 0 && phase + n <= SampleEvery)
+                    return;
+                const auto sample = static_cast<std::uint64_t>(occupancy());
+                occupancySum.add(sample);
+                occupancySamples.add();
+                highWater.raise(sample);
+            }
+
+            void onFull() noexcept
+            {
+                fullHits.add();
+            }
+
+            void onCasRetry() noexcept
+            {
+                casRetries.add();
+            }
+
+            void collect(QueueStatsSnapshot& out) const noexcept
+            {
+                out.pushes = pushes.load();
+                out.fullHits = fullHits.load();
+                out.casRetries = casRetries.load();
+                out.highWater = highWater.load();
+                out.occupancySum = occupancySum.load();
+                out.occupancySamples = occupancySamples.load();
+            }
+
+            counter pushes;
+            counter fullHits;
+            counter casRetries;
+            counter highWater;
+            counter occupancySum;
+            counter occupancySamples;
+        };
+
+        struct consumer_side
+        {
+            void onPop(std::size_t n = 1) noexcept
+            {
+                pops.add(n);
+            }
+
+            void onEmpty() noexcept
+            {
+                emptyHits.add();
+            }
+
+            void onOverrun() noexcept
+            {
+                overruns.add();
+            }
+
+            void collect(QueueStatsSnapshot& out) const noexcept
+            {
+                out.pops = pops.load();
+                out.emptyHits = emptyHits.load();
+                out.overruns = overruns.load();
+            }
+
+            detail::StatCounter pops;
+            detail::StatCounter emptyHits;
+            detail::StatCounter overruns;
+        };
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Policies usable as the `Stats` parameter of the lockedin queues.
+         */
+        template <typename Stats>
+        concept StatsPolicy = requires {
+            { Stats::enabled } -> std::convertible_to<bool>;
+            typename Stats::template producer_side<false>;
+            typename Stats::template producer_side<true>;
+            typename Stats::consumer_side;
+        };
+    } // namespace detail
+}
@@ -0,0 +1,190 @@
+/**
+ * @file reorder_buffer.hpp
+ * @brief Header-only **bounded, lock-free reorder buffer**: results produced out of order by
+ *        parallel workers go in by sequence number and come out in sequence order.
+ *
+ * ```cpp
+ * ReorderBuffer<Enriched> results(1024);
+ *
+ * // worker threads, any order
+ * while (!results.deposit(seq, enrich(order))) { }   // false while seq is too far ahead
+ *
+ * // single in-order consumer
+ * results.drain([](Enriched&& e, std::uint64_t seq) { downstream(e); });
+ * ```
+ *
+ * The buffer is a ring of `capacity` slots. Result `seq` goes to slot `seq & (capacity - 1)`
+ * and is accepted once the consumer has released everything up to `seq - capacity`; the
+ * consumer pops the slot of its next expected sequence as soon as that slot is stamped. No
+ * sorting, no search: a late result simply holds the run behind it until it lands.
+ *
+ * Each sequence must be deposited exactly once. The window (`capacity`) bounds how far the
+ * fastest worker may run ahead of the slowest one; size it to the number of workers times the
+ * results each can have in flight.
+ *
+ * ## Complexity
+ * * `deposit()` – *O(1)* / wait-free (returns false if `seq` is outside the window).
+ * * `pop()`     – *O(1)* / wait-free (returns false if the next result has not arrived).
+ * * `drain()`   – *O(n)* for a ready run of `n`, with one release store for the whole run.
+ *
+ * ## Memory ordering
+ * * Worker: acquire-load the consumer's position (the slot's previous value has been moved
+ *   out), write the value, release-store the slot's stamp (`seq + 1`).
+ * * Consumer: acquire-load the stamp of its next slot, move the value out, release-store the
+ *   new position. Stamps are unique per lap, so a slot never needs clearing.
+ *
+ * Slots are padded to a cache line so that workers finishing neighbouring sequences do not
+ * write to the same line.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+
+#include <atomic>
+#include <bitset>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace lockedin
+{
+    /**
+     * @tparam T Result type; must be default constructible and move assignable.
+     *
+     * @class ReorderBuffer
+     * @brief Many depositing workers, one consumer that receives results in sequence order.
+     */
+    template <typename T> class ReorderBuffer
+    {
+    public:
+        /**
+         * @param capacity Window size; must be a **power of 2**.
+         * @param first    Sequence of the first result.
+         * @throws std::logic_error if capacity is invalid (<2 or not power of 2).
+         */
+        explicit ReorderBuffer(std::size_t capacity, std::uint64_t first = 0)
+            : capacity_{capacity}, slots_{std::make_unique<Slot[]>(capacity)}, next_{first}
+        {
+            if (capacity < 2 || std::bitset<sizeof(std::size_t) * CHAR_BIT>(capacity).count() != 1)
+                throw std::logic_error("Capacity must be a power of 2, and greater than 1.");
+            consumed_.store(first, std::memory_order_relaxed);
+        }
+
+        ReorderBuffer(const ReorderBuffer&) = delete;
+        ReorderBuffer& operator=(const ReorderBuffer&) = delete;
+        ReorderBuffer(ReorderBuffer&&) = delete;
+        ReorderBuffer& operator=(ReorderBuffer&&) = delete;
+
+        ~ReorderBuffer() = default;
+
+        /* ------------------------------------------------------------------
+         * Worker API (any thread)
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Stores the result of `seq` by copy.
+         * @return true if stored, false if `seq` is `capacity` or more ahead of the consumer.
+         */
+        bool deposit(std::uint64_t seq, const T& value)
+        {
+            return store(seq, value);
+        }
+
+        /**
+         * @brief Stores the result of `seq` by move.
+         * @return true if stored, false if `seq` is `capacity` or more ahead of the consumer.
+         */
+        bool deposit(std::uint64_t seq, T&& value)
+        {
+            return store(seq, std::move(value));
+        }
+
+        /* ------------------------------------------------------------------
+         * Consumer API (single thread)
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Takes the next result in sequence order.
+         * @return true if successful, false if it has not been deposited yet.
+         */
+        bool pop(T& item)
+        {
+            Slot& slot = slots_[next_ & (capacity_ - 1)];
+            if (slot.stamp.load(std::memory_order_acquire) != stamp(next_))
+                return false;
+            item = std::move(slot.value);
+            consumed_.store(++next_, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Passes the ready run of results to `fn(T&&, std::uint64_t seq)`, in order,
+         *        and releases their slots with a single store.
+         * @return the number of results delivered (0 if the next one has not arrived).
+         */
+        template <typename Fn>
+        std::size_t drain(Fn&& fn, std::size_t max = std::numeric_limits<std::size_t>::max())
+        {
+            std::size_t n = 0;
+            for (; n < max; ++n, ++next_)
+            {
+                Slot& slot = slots_[next_ & (capacity_ - 1)];
+                if (slot.stamp.load(std::memory_order_acquire) != stamp(next_))
+                    break;
+                fn(std::move(slot.value), next_);
+            }
+            if (n != 0)
+                consumed_.store(next_, std::memory_order_release);
+            return n;
+        }
+
+        /* ------------------------------------------------------------------
+         * Status API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Sequence the consumer expects next; results below it have been delivered.
+         */
+        [[nodiscard]] std::uint64_t next() const noexcept
+        {
+            return consumed_.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+    private:
+        struct alignas(detail::cacheline_size) Slot
+        {
+            std::atomic<std::uint64_t> stamp{0}; ///< seq + 1 once `value` holds result `seq`
+            T value{};
+        };
+
+        static constexpr std::uint64_t stamp(std::uint64_t seq) noexcept
+        {
+            return seq + 1;
+        }
+
+        template <typename U> bool store(std::uint64_t seq, U&& value)
+        {
+            if (seq - consumed_.load(std::memory_order_acquire) >= capacity_)
+                return false; // outside the window (too far ahead)
+            Slot& slot = slots_[seq & (capacity_ - 1)];
+            slot.value = std::forward<U>(value);
+            slot.stamp.store(stamp(seq), std::memory_order_release);
+            return true;
+        }
+
+        const std::size_t capacity_;
+        std::unique_ptr<Slot[]> slots_;
+        alignas(detail::cacheline_size) std::atomic<std::uint64_t> consumed_{0}; ///< for workers
+        alignas(detail::cacheline_size) std::uint64_t next_; ///< consumer only
+    };
+}
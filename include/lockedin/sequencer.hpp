@@ -0,0 +1,445 @@
+/**
+ * @file sequencer.hpp
+ * @brief Header-only **Disruptor-style sequencer** with a consumer dependency graph.
+ *
+ * `SPMCQ` lets every consumer read independently and lets the producer lap slow readers.
+ * Staged pipelines (journal → replicate → business logic) need the opposite: stage B may only
+ * see slot i once stage A is done with it, and the producer must never overwrite a slot the
+ * slowest terminal stage has not processed. The pieces are the ones from the LMAX Disruptor:
+ *
+ * * `Sequence`            – a cache-line padded, monotonically increasing 64-bit counter.
+ * * `SequencedRing`       – preallocated power-of-2 ring plus the single-producer claim logic.
+ *                           The producer only reads the *gating* sequences when its cached
+ *                           minimum says the ring may be full.
+ * * `SequenceBarrier`     – what a stage waits on: the producer cursor and the sequences of
+ *                           the stages it depends on.
+ * * `BatchEventProcessor` – runs a handler over every available slot in one batch, then
+ *                           publishes its own sequence once per batch.
+ *
+ * Events are updated in place; each stage owns the fields it writes.
+ *
+ * ## Wiring
+ * Barriers and gating sequences are configured before the producer and processors start:
+ *
+ * ```cpp
+ * SequencedRing<Order> ring(1024);
+ * BatchEventProcessor journal(ring, ring.newBarrier(), journalHandler);
+ * BatchEventProcessor replicate(ring, ring.newBarrier({&journal.sequence()}), replicateHandler);
+ * BatchEventProcessor business(ring, ring.newBarrier({&replicate.sequence()}), businessHandler);
+ * ring.addGatingSequences({&business.sequence()});
+ * ```
+ *
+ * ## Memory ordering
+ * * Producer: writes the slot, then `store(release)` on the cursor.
+ * * Stages: `load(acquire)` on the cursor / dependency sequences, process, then
+ *   `store(release)` on their own sequence, which the producer reads with `acquire` before
+ *   reusing a slot.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/wait_strategy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lockedin
+{
+    /**
+     * @class Sequence
+     * @brief Padded atomic counter; starts at -1 (nothing published / processed yet).
+     */
+    class alignas(detail::cacheline_size) Sequence
+    {
+    public:
+        static constexpr std::int64_t initial = -1;
+
+        explicit Sequence(std::int64_t value = initial) noexcept : value_{value}
+        {
+        }
+
+        [[nodiscard]] std::int64_t get() const noexcept
+        {
+            return value_.load(std::memory_order_acquire);
+        }
+
+        void set(std::int64_t value) noexcept
+        {
+            value_.store(value, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<std::int64_t> value_;
+    };
+
+    namespace detail
+    {
+        inline std::int64_t minimumSequence(const std::vector<const Sequence*>& sequences,
+                                            std::int64_t minimum) noexcept
+        {
+            for (const auto* sequence : sequences)
+                minimum = std::min(minimum, sequence->get());
+            return minimum;
+        }
+    } // namespace detail
+
+    /**
+     * @class SequenceBarrier
+     * @brief Waits until a sequence is published by the producer *and* processed by every
+     *        dependency.
+     */
+    template <typename Wait = BusySpinWait>
+        requires detail::WaitStrategy<Wait>
+    class SequenceBarrier
+    {
+    public:
+        SequenceBarrier(const Sequence& cursor, std::vector<const Sequence*> dependencies)
+            : cursor_{cursor}, dependencies_{std::move(dependencies)}
+        {
+        }
+
+        /**
+         * @brief Highest sequence available to this stage, without waiting.
+         */
+        [[nodiscard]] std::int64_t available() const noexcept
+        {
+            const auto published = cursor_.get();
+            return dependencies_.empty() ? published
+                                         : detail::minimumSequence(dependencies_, published);
+        }
+
+        /**
+         * @brief Waits until `sequence` is available.
+         * @return the highest available sequence (>= `sequence`), or a value below `sequence`
+         *         if the barrier was alerted.
+         */
+        std::int64_t waitFor(std::int64_t sequence)
+        {
+            auto highest = available();
+            const auto ready = [&]
+            { return available() >= sequence || alerted_.load(std::memory_order_acquire); };
+            while (highest < sequence)
+            {
+                if (alerted_.load(std::memory_order_acquire))
+                    return highest;
+                wait_.idle(ready);
+                highest = available();
+            }
+            wait_.reset();
+            return highest;
+        }
+
+        /**
+         * @brief Wakes the waiting stage and makes `waitFor` return early.
+         */
+        void alert() noexcept
+        {
+            alerted_.store(true, std::memory_order_release);
+            wait_.notify();
+        }
+
+        void clearAlert() noexcept
+        {
+            alerted_.store(false, std::memory_order_release);
+        }
+
+        /**
+         * @brief Called by publishers (producer or upstream stages) after advancing.
+         */
+        void signal() noexcept
+        {
+            wait_.notify();
+        }
+
+    private:
+        const Sequence& cursor_;
+        std::vector<const Sequence*> dependencies_;
+        alignas(detail::cacheline_size) std::atomic<bool> alerted_{false};
+        alignas(detail::cacheline_size) Wait wait_;
+    };
+
+    /**
+     * @tparam T    Event type, preallocated and reused in place.
+     * @tparam Wait Idle policy used by the barriers created from this ring.
+     *
+     * @class SequencedRing
+     * @brief Single-producer ring whose slots are recycled only after every gating sequence
+     *        has passed them.
+     */
+    template <typename T, typename Wait = BusySpinWait>
+        requires detail::WaitStrategy<Wait>
+    class SequencedRing
+    {
+    public:
+        using barrier_type = SequenceBarrier<Wait>;
+
+        /**
+         * @param capacity Must be a **power of 2** and greater than 1.
+         * @throws std::logic_error if capacity is invalid.
+         */
+        explicit SequencedRing(std::size_t capacity)
+            : capacity_{capacity}, mask_{capacity - 1}, events_{std::make_unique<T[]>(capacity)}
+        {
+            if (capacity_ < 2 || (capacity_ & (capacity_ - 1)) != 0)
+                throw std::logic_error("Capacity must be a power of 2, and greater than 1.");
+        }
+
+        SequencedRing(const SequencedRing&) = delete;
+        SequencedRing& operator=(const SequencedRing&) = delete;
+        SequencedRing(SequencedRing&&) = delete;
+        SequencedRing& operator=(SequencedRing&&) = delete;
+
+        ~SequencedRing() = default;
+
+        /* ------------------------------------------------------------------
+         * Wiring (before the producer and processors start)
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Creates a barrier over the cursor and the given upstream sequences.
+         * The ring owns the barrier; the reference stays valid for the ring's lifetime.
+         */
+        barrier_type& newBarrier(std::initializer_list<const Sequence*> dependencies = {})
+        {
+            barriers_.push_back(std::make_unique<barrier_type>(
+                cursor_, std::vector<const Sequence*>(dependencies)));
+            return *barriers_.back();
+        }
+
+        /**
+         * @brief Registers the sequences the producer must not overrun (the terminal stages).
+         */
+        void addGatingSequences(std::initializer_list<const Sequence*> sequences)
+        {
+            gating_.insert(gating_.end(), sequences.begin(), sequences.end());
+        }
+
+        /* ------------------------------------------------------------------
+         * Producer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Claims the next `n` sequences, spinning while the ring is full.
+         * @return the highest claimed sequence.
+         */
+        std::int64_t next(std::size_t n = 1)
+        {
+            std::int64_t claimed = 0;
+            for (std::uint32_t spins = 0; !tryNext(claimed, n); ++spins)
+                if (spins < 64)
+                    detail::cpu_relax();
+                else
+                    std::this_thread::yield();
+            return claimed;
+        }
+
+        /**
+         * @brief Claims the next `n` sequences if there is room.
+         * @param highest Set to the highest claimed sequence on success.
+         * @return true if successful, false if the slowest gating stage is too far behind.
+         */
+        bool tryNext(std::int64_t& highest, std::size_t n = 1)
+        {
+            if (n == 0 || n > capacity_)
+                throw std::logic_error("Claim size must be in [1, capacity].");
+
+            const auto nextSequence = nextValue_ + static_cast<std::int64_t>(n);
+            const auto wrapPoint = nextSequence - static_cast<std::int64_t>(capacity_);
+            if (wrapPoint > cachedGating_)
+            {
+                // Only now pay for reading the consumers' cache lines.
+                cachedGating_ = detail::minimumSequence(gating_, nextValue_);
+                if (wrapPoint > cachedGating_)
+                    return false; // Full
+            }
+            nextValue_ = nextSequence;
+            highest = nextSequence;
+            return true;
+        }
+
+        /**
+         * @brief Makes every sequence up to and including `highest` visible to the stages.
+         */
+        void publish(std::int64_t highest) noexcept
+        {
+            cursor_.set(highest);
+            signalAll();
+        }
+
+        /**
+         * @brief Claims one slot, lets `fill(event, sequence)` write it, then publishes.
+         */
+        template <typename Fill> void publishEvent(Fill&& fill)
+        {
+            const auto sequence = next();
+            std::invoke(std::forward<Fill>(fill), (*this)[sequence], sequence);
+            publish(sequence);
+        }
+
+        /* ------------------------------------------------------------------
+         * Shared API
+         * ----------------------------------------------------------------*/
+
+        [[nodiscard]] T& operator[](std::int64_t sequence) noexcept
+        {
+            return events_[static_cast<std::size_t>(sequence) & mask_];
+        }
+
+        [[nodiscard]] const Sequence& cursor() const noexcept
+        {
+            return cursor_;
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        /**
+         * @brief Wakes every barrier; called by the producer and by processors after they
+         *        advance, so downstream stages using a blocking wait strategy re-check.
+         */
+        void signalAll() noexcept
+        {
+            for (auto& barrier : barriers_)
+                barrier->signal();
+        }
+
+    private:
+        /* ------------------------------------------------------------------
+         * Storage
+         * ----------------------------------------------------------------*/
+        std::size_t capacity_;
+        std::size_t mask_;
+        std::unique_ptr<T[]> events_;
+        std::vector<std::unique_ptr<barrier_type>> barriers_;
+        std::vector<const Sequence*> gating_;
+
+        Sequence cursor_; ///< highest published sequence (own cache line)
+
+        // Producer-local claim state, on its own line.
+        alignas(detail::cacheline_size) std::int64_t nextValue_{Sequence::initial};
+        std::int64_t cachedGating_{Sequence::initial};
+    };
+
+    /**
+     * @tparam Handler Callable `handler(T& event, std::int64_t sequence, bool endOfBatch)`.
+     *
+     * @class BatchEventProcessor
+     * @brief One pipeline stage: drains everything its barrier allows in one batch and
+     *        publishes its progress once per batch.
+     */
+    template <typename T, typename Handler, typename Wait = BusySpinWait>
+    class BatchEventProcessor
+    {
+    public:
+        BatchEventProcessor(SequencedRing<T, Wait>& ring, SequenceBarrier<Wait>& barrier,
+                            Handler handler)
+            : ring_{ring}, barrier_{barrier}, handler_{std::move(handler)}
+        {
+        }
+
+        BatchEventProcessor(const BatchEventProcessor&) = delete;
+        BatchEventProcessor& operator=(const BatchEventProcessor&) = delete;
+
+        /**
+         * @brief This stage's progress; downstream barriers and the ring's gating use it.
+         */
+        [[nodiscard]] const Sequence& sequence() const noexcept
+        {
+            return sequence_;
+        }
+
+        /**
+         * @brief Processes until `halt()` is called. Intended as a thread's body.
+         *
+         * A `halt()` issued before `run()` starts is not lost: `run()` returns at once and the
+         * processor becomes idle again, ready for another `run()`.
+         * @throws std::logic_error if the processor is already running.
+         */
+        void run()
+        {
+            barrier_.clearAlert(); // before the CAS, so a halt() after it stays alerted
+            auto expected = State::Idle;
+            if (!state_.compare_exchange_strong(expected, State::Running,
+                                                std::memory_order_acq_rel))
+            {
+                if (expected == State::Running)
+                    throw std::logic_error("BatchEventProcessor is already running.");
+                state_.store(State::Idle, std::memory_order_release); // halted before start
+                return;
+            }
+
+            while (state_.load(std::memory_order_acquire) == State::Running)
+            {
+                const auto next = sequence_.get() + 1;
+                const auto available = barrier_.waitFor(next);
+                if (available >= next)
+                    processBatch(next, available);
+            }
+            state_.store(State::Idle, std::memory_order_release);
+        }
+
+        /**
+         * @brief Processes whatever is available right now, without waiting.
+         * @return the number of events handled.
+         */
+        std::size_t processAvailable()
+        {
+            const auto next = sequence_.get() + 1;
+            const auto available = barrier_.available();
+            if (available < next)
+                return 0;
+            processBatch(next, available);
+            return static_cast<std::size_t>(available - next + 1);
+        }
+
+        /**
+         * @brief Stops `run()` after its current batch, or makes the next `run()` return at
+         *        once if it has not started yet.
+         */
+        void halt() noexcept
+        {
+            state_.store(State::Halted, std::memory_order_release);
+            barrier_.alert();
+        }
+
+        [[nodiscard]] bool isRunning() const noexcept
+        {
+            return state_.load(std::memory_order_acquire) == State::Running;
+        }
+
+    private:
+        enum class State : std::uint8_t
+        {
+            Idle,
+            Running,
+            Halted
+        };
+
+        void processBatch(std::int64_t first, std::int64_t last)
+        {
+            for (auto sequence = first; sequence <= last; ++sequence)
+                std::invoke(handler_, ring_[sequence], sequence, sequence == last);
+            sequence_.set(last);
+            ring_.signalAll();
+        }
+
+        SequencedRing<T, Wait>& ring_;
+        SequenceBarrier<Wait>& barrier_;
+        Handler handler_;
+        Sequence sequence_;
+        alignas(detail::cacheline_size) std::atomic<State> state_{State::Idle};
+    };
+}
@@ -17,6 +17,67 @@
  * * The consumer mirrors that pattern: loads the producer cursor with acquire, then releases
  *   progress with a store once the slot has been reclaimed.
  *
+ * ## Sequence numbers and replay
+ * Every message carries a global, monotonically increasing sequence (0, 1, 2, ...). Each slot
+ * is a small seqlock: the producer clears its stamp, writes the data, then stamps it with the
+ * sequence, and readers check the stamp before and after copying. That makes the last
+ * `capacity - 1` messages safely addressable from any thread: `readAt(seq)` fetches one and
+ * `readRange(first, last, fn)` walks retained history, e.g. for gap recovery.
+ * A reader racing the producer may copy a half-written payload before the stamp check rejects
+ * it, so these history reads require a trivially copyable `T`; copying a torn `std::string`
+ * would already be undefined behaviour.
+ *
+ * ## Zero-copy reads
+ * `SPMCConsumer::readBatch(fn, max)` hands `fn` an `SPMCView` over up to `max` ready slots that
+ * are contiguous in the ring (so at most two views per call, split at the wrap). The producer
+ * cursor is loaded once per batch and the batch is validated once, after `fn` returns, by
+ * re-checking the stamp of its oldest slot: the producer overwrites slots in order, so if the
+ * oldest one is intact, all of them are. `peek(fn)` does the same for a single message without
+ * consuming it. As with any seqlock, a lossy consumer's `fn` may observe a torn message; an
+ * overrun is reported (exception) only after `fn` has returned, so `fn` must not act on the
+ * data irrevocably. Reliable consumers are never overwritten and can use views freely.
+ *
+ * ## Topic filtering
+ * `push(item, tag)` stores a 64-bit tag (an instrument id, a topic bitmask, ...) next to the
+ * slot's stamp, on the cache line the readers already load to validate a slot, never on the
+ * payload's. `SPMCConsumer::skipNonMatching(match)` jumps over a run of messages whose tag
+ * fails `match(tag)`, and `popMatching(item, match)` copies out the next message that passes.
+ * The tag is read under the same seqlock check as the payload, so a skipped message was never
+ * torn. `push(item)` tags with 0.
+ *
+ * A skipped message still costs one cache line, its stamp line: the saving is the payload's
+ * lines and the copy, not the per-slot miss. It pays off when `T` spans several lines; for a
+ * payload that fits in one line, a skip reads half of what `pop()` would. Tags are not packed
+ * densely, since the stamp has to be read to validate the tag anyway.
+ *
+ * ## Reliable (gating) consumers
+ * By default the producer never waits: it laps slow consumers, which then throw from `pop()`.
+ * A consumer obtained with `getReliableConsumer()` instead registers its cursor (a global
+ * sequence) in a cache-line padded registry, and the producer
+ * refuses to overwrite a message any registered consumer has not read yet: `push()` returns
+ * false. The producer keeps a cached minimum of the registered cursors and only rescans the
+ * registry when that cached value says the ring is full, so while gating consumers keep up the
+ * fast path touches no consumer cache line. Lossy and reliable consumers can share one ring.
+ *
+ * ## Joining and leaving
+ * Consumers can join at any time, at the producer's current position (`SPMCJoin::Tail`), at
+ * the oldest message still retained (`SPMCJoin::Oldest`) or at an explicit sequence
+ * (`getConsumerAt`), either lossy or reliable. `detach()` (or destruction) removes a reliable
+ * consumer from the registry, after which the producer no longer waits for it.
+ *
+ * Joining reliably at the tail is exact. Joining behind it is exact too, but may have to wait:
+ * the producer publishes the floor its cached minimum allows it to overwrite down to, and a
+ * join starting below that floor bumps a registry epoch the producer checks on every push,
+ * then waits until the producer has rescanned (i.e. until its next push). An `Oldest` join
+ * whose start was overwritten meanwhile moves up to the new oldest message; `getConsumerAt`
+ * throws `std::out_of_range` instead.
+ * Copying a reliable consumer registers a new cursor at the same position.
+ *
+ * ## Telemetry
+ * With a `QueueStats<>` policy the producer counters live next to `mWriteIndex` in the queue,
+ * while each consumer handle carries its own pop/empty/overrun counters next to its cursor.
+ * `SPMCQ::stats()` and `SPMCConsumer::stats()` can be read from any thread.
+ *
  * ## Credit
  *
  * ![David Gross __When Nanoseconds Matter: Ultrafast Trading Systems in C++__ (CppCon 2024)]
@@ -28,40 +89,186 @@
 #pragma once
 
 #include <lockedin/abstract_queue.hpp>
+#include <lockedin/queue_stats.hpp>
 
 #include <atomic>
 #include <bitset>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <new>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
 namespace lockedin
 {
 
-    template <typename T> class SPMCQ;
-    template <typename T> class SPMCProducer;
-    template <typename T> class SPMCConsumer;
+    template <typename T, detail::StatsPolicy Stats = NoStats> class SPMCQ;
+    template <typename T, detail::StatsPolicy Stats = NoStats> class SPMCProducer;
+    template <typename T, detail::StatsPolicy Stats = NoStats> class SPMCConsumer;
     template <typename T> struct SPMCQEntry;
 
+    /**
+     * @brief Where a new consumer starts reading.
+     */
+    enum class SPMCJoin
+    {
+        Tail,   ///< only messages published after joining
+        Oldest, ///< the oldest message still retained in the ring
+    };
+
+    /**
+     * @brief Whether the producer may lap a consumer.
+     */
+    enum class SPMCMode
+    {
+        Lossy,    ///< never slows the producer; overrun surfaces as an exception
+        Reliable, ///< registered cursor; the producer waits for it
+    };
+
     /**
      * @brief struct for an element inside the queue containing the data and version number.
+     *
+     * `version` is the message's sequence + 1 once `data` is complete, and `writing` (0) while
+     * the slot is empty or being overwritten. `tag` shares the stamp's cache line so filters can
+     * run without touching `data`; they still load that line once per slot.
      */
     template <typename T> struct SPMCQEntry
     {
+        static constexpr std::uint64_t writing = 0;
+
+        static constexpr std::uint64_t stamp(std::uint64_t sequence) noexcept
+        {
+            return sequence + 1;
+        }
+
         T data;
-        alignas(detail::cacheline_size) uint32_t version{0};
+        alignas(detail::cacheline_size) std::atomic<std::uint64_t> version{writing};
+        std::atomic<std::uint64_t> tag{0};
+    };
+
+    /**
+     * @class SPMCView
+     * @brief Read-only, span-like view over consecutive ring slots. The payloads are strided
+     *        (each sits in its own padded entry), so the view iterates entries, not `T[]`.
+     */
+    template <typename T> class SPMCView
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator() = default;
+            explicit iterator(const SPMCQEntry<T>* entry) noexcept : entry_{entry}
+            {
+            }
+
+            reference operator*() const noexcept
+            {
+                return entry_->data;
+            }
+
+            pointer operator->() const noexcept
+            {
+                return &entry_->data;
+            }
+
+            iterator& operator++() noexcept
+            {
+                ++entry_;
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                auto previous = *this;
+                ++entry_;
+                return previous;
+            }
+
+            bool operator==(const iterator&) const = default;
+
+        private:
+            const SPMCQEntry<T>* entry_{nullptr};
+        };
+
+        SPMCView(const SPMCQEntry<T>* first, size_t count) noexcept : first_{first}, count_{count}
+        {
+        }
+
+        [[nodiscard]] iterator begin() const noexcept
+        {
+            return iterator(first_);
+        }
+
+        [[nodiscard]] iterator end() const noexcept
+        {
+            return iterator(first_ + count_);
+        }
+
+        [[nodiscard]] const T& operator[](size_t i) const noexcept
+        {
+            return first_[i].data;
+        }
+
+        [[nodiscard]] const T& front() const noexcept
+        {
+            return first_->data;
+        }
+
+        [[nodiscard]] const T& back() const noexcept
+        {
+            return first_[count_ - 1].data;
+        }
+
+        [[nodiscard]] size_t size() const noexcept
+        {
+            return count_;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return count_ == 0;
+        }
+
+    private:
+        const SPMCQEntry<T>* first_;
+        size_t count_;
     };
 
+    namespace detail
+    {
+        /**
+         * @brief One registry slot: the next sequence a reliable consumer will read.
+         */
+        struct alignas(cacheline_size) SPMCGatingCursor
+        {
+            static constexpr std::uint64_t vacant = std::numeric_limits<std::uint64_t>::max();
+            std::atomic<std::uint64_t> cursor{vacant};
+        };
+    } // namespace detail
+
     /**
      * @tparam T Element type transported through the queue.
+     * @tparam Stats Telemetry policy (`NoStats` or `QueueStats<>`).
      *
      * @class SPMCQ
      * @brief Lock-free, wait-free ring buffer skeleton with one consumer and N producers.
      */
-    template <typename T> class SPMCQ : public AbstractSharedQ<T, SPMCQ<T>>
+    template <typename T, detail::StatsPolicy Stats>
+    class SPMCQ : public AbstractSharedQ<T, SPMCQ<T, Stats>>
     {
     public:
         using elem = SPMCQEntry<T>;
@@ -69,11 +276,13 @@ namespace lockedin
         /**
          * @brief Construct with a specific capacity.
          * @param capacity Must be a **power of 2** (e.g., 64, 1024) to allow efficient wrapping.
+         * @param maxReliableConsumers Size of the gating cursor registry.
          * @throws std::logic_error if capacity is invalid (<2 or not power of 2).
          */
-        explicit SPMCQ(size_t capacity)
-            : AbstractSharedQ<T, SPMCQ<T>>(capacity), capacity_{capacity},
-              items_{std::make_unique<elem[]>(capacity)}
+        explicit SPMCQ(size_t capacity, size_t maxReliableConsumers = 8)
+            : AbstractSharedQ<T, SPMCQ<T, Stats>>(capacity), capacity_{capacity},
+              items_{std::make_unique<elem[]>(capacity)}, gatingSlots_{maxReliableConsumers},
+              gating_{std::make_unique<detail::SPMCGatingCursor[]>(maxReliableConsumers)}
         {
             if (capacity < 2 || std::bitset<sizeof(size_t) * CHAR_BIT>(capacity).count() != 1)
                 throw std::logic_error("Capacity must be a power of 2, and greater than 1.");
@@ -93,17 +302,56 @@ namespace lockedin
         /**
          * @brief Obtain a producer handle sharing this queue.
          */
-        [[nodiscard]] constexpr SPMCProducer<T> getProducer() const noexcept
+        [[nodiscard]] constexpr SPMCProducer<T, Stats> getProducer() const noexcept
         {
-            return SPMCProducer<T>(const_cast<SPMCQ<T>&>(*this));
+            return SPMCProducer<T, Stats>(const_cast<SPMCQ&>(*this));
         }
 
         /**
-         * @brief Obtain a consumer handle sharing this queue.
+         * @brief Obtain a lossy consumer handle starting at the oldest retained message.
          */
-        [[nodiscard]] SPMCConsumer<T> getConsumer() const noexcept
+        [[nodiscard]] SPMCConsumer<T, Stats> getConsumer() const noexcept
         {
-            return SPMCConsumer<T>(const_cast<SPMCQ<T>&>(*this));
+            SPMCConsumer<T, Stats> consumer(const_cast<SPMCQ&>(*this));
+            consumer.seek(oldest());
+            return consumer;
+        }
+
+        /**
+         * @brief Obtain a consumer joining at the tail or at the oldest retained message.
+         * @throws std::runtime_error if `mode` is reliable and every registry slot is taken.
+         */
+        [[nodiscard]] SPMCConsumer<T, Stats> getConsumer(SPMCJoin where,
+                                                         SPMCMode mode = SPMCMode::Lossy) const
+        {
+            if (where == SPMCJoin::Tail)
+                return join(sequence(), mode, Start::Tail);
+            return join(oldest(), mode, Start::Oldest);
+        }
+
+        /**
+         * @brief Obtain a consumer whose first message is `sequence` (may lie in the future).
+         * A reliable join below the producer's gating floor waits for its next push.
+         * @throws std::out_of_range if `sequence` has already left the ring.
+         * @throws std::runtime_error if `mode` is reliable and every registry slot is taken.
+         */
+        [[nodiscard]] SPMCConsumer<T, Stats> getConsumerAt(std::uint64_t sequence,
+                                                           SPMCMode mode = SPMCMode::Lossy) const
+        {
+            if (sequence < oldest())
+                throw std::out_of_range("SPMCQ sequence " + std::to_string(sequence) +
+                                        " is no longer retained");
+            return join(sequence, mode, Start::Exact);
+        }
+
+        /**
+         * @brief Obtain a consumer the producer will never overrun, starting at the producer's
+         *        current position.
+         * @throws std::runtime_error if every registry slot is taken.
+         */
+        [[nodiscard]] SPMCConsumer<T, Stats> getReliableConsumer() const
+        {
+            return getConsumer(SPMCJoin::Tail, SPMCMode::Reliable);
         }
 
         /* ------------------------------------------------------------------
@@ -142,19 +390,220 @@ namespace lockedin
             return (writeIdx - readIdx) & (capacity_ - 1U);
         }
 
+        [[nodiscard]] size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        /**
+         * @brief Sequence the next published message will carry (= messages published so far).
+         */
+        [[nodiscard]] std::uint64_t sequence() const noexcept
+        {
+            return mSequence.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Oldest sequence that can still be read. The slot of the message published
+         *        `capacity` ago may be mid-overwrite, so it does not count.
+         */
+        [[nodiscard]] std::uint64_t oldest() const noexcept
+        {
+            const auto published = sequence();
+            return published >= capacity_ ? published - capacity_ + 1 : 0;
+        }
+
+        /* ------------------------------------------------------------------
+         * History API (any thread)
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Copies message `sequence` out of the ring.
+         * @return true if successful, false if it is not published yet or was overwritten
+         *         (compare against `sequence()` / `oldest()` to tell which).
+         */
+        bool readAt(std::uint64_t sequence, T& item) const
+            requires std::is_trivially_copyable_v<T>
+        {
+            return sequence < this->sequence() && copyIfCurrent(sequence, item);
+        }
+
+        /**
+         * @brief Calls `fn(sequence, const T&)` for every retained message in `[first, last)`,
+         *        in order, stopping at the first one that has been overwritten meanwhile.
+         * @return the first sequence not delivered.
+         */
+        template <typename Fn>
+        std::uint64_t readRange(std::uint64_t first, std::uint64_t last, Fn&& fn) const
+            requires std::is_trivially_copyable_v<T>
+        {
+            const auto published = sequence();
+            const auto from = first < oldest() ? oldest() : first;
+            const auto to = last < published ? last : published;
+            T item{};
+            auto seq = from;
+            for (; seq < to && copyIfCurrent(seq, item); ++seq)
+                fn(seq, static_cast<const T&>(item));
+            return seq;
+        }
+
+        /**
+         * @brief Number of reliable consumers currently registered.
+         */
+        [[nodiscard]] size_t reliableConsumers() const noexcept
+        {
+            size_t count = 0;
+            for (size_t i = 0; i < gatingSlots_; ++i)
+                count += gating_[i].cursor.load(std::memory_order_relaxed) !=
+                         detail::SPMCGatingCursor::vacant;
+            return count;
+        }
+
+        /**
+         * @brief Snapshot of the producer-side counters; safe to call from any thread.
+         * Consumer-side counters are per handle, see `SPMCConsumer::stats()`.
+         */
+        [[nodiscard]] QueueStatsSnapshot stats() const noexcept
+            requires Stats::enabled
+        {
+            QueueStatsSnapshot snapshot;
+            producerStats_.collect(snapshot);
+            return snapshot;
+        }
+
     private:
-        friend class SPMCProducer<T>;
-        friend class SPMCConsumer<T>;
+        friend class SPMCProducer<T, Stats>;
+        friend class SPMCConsumer<T, Stats>;
+
+        /**
+         * @brief Seqlock read of the slot holding `sequence`.
+         * @return false if that slot no longer (or not yet) holds `sequence`.
+         */
+        bool copyIfCurrent(std::uint64_t sequence, T& item) const
+        {
+            const elem& slot = items_[static_cast<size_t>(sequence & (capacity_ - 1))];
+            const auto expected = elem::stamp(sequence);
+            if (slot.version.load(std::memory_order_acquire) != expected)
+                return false;
+            item = slot.data;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return slot.version.load(std::memory_order_relaxed) == expected;
+        }
+
+        /**
+         * @brief Seqlock read of the tag of `sequence`, without touching the payload.
+         * @return false if that slot no longer (or not yet) holds `sequence`.
+         */
+        bool tagIfCurrent(std::uint64_t sequence, std::uint64_t& tag) const noexcept
+        {
+            const elem& slot = items_[static_cast<size_t>(sequence & (capacity_ - 1))];
+            const auto expected = elem::stamp(sequence);
+            if (slot.version.load(std::memory_order_acquire) != expected)
+                return false;
+            tag = slot.tag.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return slot.version.load(std::memory_order_relaxed) == expected;
+        }
+
+        /**
+         * @brief Where a join starts; decides what happens if the producer got there first.
+         */
+        enum class Start
+        {
+            Tail,   ///< follow the producer's position
+            Oldest, ///< move up to the new oldest message
+            Exact,  ///< throw std::out_of_range
+        };
+
+        SPMCConsumer<T, Stats> join(std::uint64_t start, SPMCMode mode, Start kind) const
+        {
+            auto& self = const_cast<SPMCQ&>(*this);
+            SPMCConsumer<T, Stats> consumer(self);
+            consumer.seek(start);
+            if (mode == SPMCMode::Reliable)
+            {
+                consumer.attach(self.registerCursor(start), kind == Start::Tail);
+                if (kind != Start::Tail)
+                    self.secure(consumer, kind == Start::Oldest);
+            }
+            return consumer;
+        }
+
+        /**
+         * @brief Makes sure the producer has seen a cursor registered behind its position.
+         *
+         * Pairs with `SPMCProducer::refreshGating()`: either this join reads the floor the
+         * producer is allowed to overwrite down to, or the producer sees the bumped epoch and
+         * rescans before its next push. Below the floor, wait for that rescan.
+         */
+        void secure(SPMCConsumer<T, Stats>& consumer, bool clamp)
+        {
+            const auto epoch = registryEpoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (consumer.position() >= gatingFloor_.load(std::memory_order_relaxed))
+                return;
+            while (registryAck_.load(std::memory_order_acquire) < epoch)
+                std::this_thread::yield();
+
+            const auto first = oldest();
+            if (consumer.position() >= first)
+                return;
+            if (!clamp)
+            {
+                const auto sequence = consumer.position();
+                consumer.detach();
+                throw std::out_of_range("SPMCQ sequence " + std::to_string(sequence) +
+                                        " is no longer retained");
+            }
+            consumer.seek(first);
+            consumer.gating_->cursor.store(first, std::memory_order_release);
+        }
+
+        /**
+         * @brief Claims a vacant registry slot holding `sequence`.
+         */
+        detail::SPMCGatingCursor& registerCursor(std::uint64_t sequence)
+        {
+            for (size_t i = 0; i < gatingSlots_; ++i)
+            {
+                auto vacant = detail::SPMCGatingCursor::vacant;
+                if (gating_[i].cursor.compare_exchange_strong(vacant, sequence,
+                                                              std::memory_order_seq_cst))
+                    return gating_[i];
+            }
+            throw std::runtime_error("SPMCQ reliable consumer registry is full");
+        }
+
+        /**
+         * @brief Oldest sequence still needed by a reliable consumer, or `bound` if none is.
+         */
+        [[nodiscard]] std::uint64_t minimumCursor(std::uint64_t bound) const noexcept
+        {
+            for (size_t i = 0; i < gatingSlots_; ++i)
+            {
+                const auto cursor = gating_[i].cursor.load(std::memory_order_acquire);
+                bound = cursor < bound ? cursor : bound;
+            }
+            return bound;
+        }
 
         /* ------------------------------------------------------------------
          * Storage
          * ----------------------------------------------------------------*/
         const size_t capacity_;         ///< total usable slots (power of 2)
         std::unique_ptr<elem[]> items_; ///< heap allocated buffer shared by handles
+        const size_t gatingSlots_;      ///< registry size
+        std::unique_ptr<detail::SPMCGatingCursor[]> gating_; ///< reliable consumer cursors
 
         // Align atomic indices to separate cache lines to prevent false sharing
         alignas(detail::cacheline_size) std::atomic<size_t> mReadIndex{0};
+        std::atomic<std::uint64_t> mSequence{0}; ///< messages published so far
         alignas(detail::cacheline_size) std::atomic<size_t> mWriteIndex{0};
+        // Written only by joins behind the tail and by the producer's registry rescans
+        alignas(detail::cacheline_size) std::atomic<std::uint64_t> registryEpoch_{0};
+        std::atomic<std::uint64_t> registryAck_{0}; ///< last epoch the producer rescanned for
+        std::atomic<std::uint64_t> gatingFloor_{0}; ///< producer's cached minimum
+        [[no_unique_address]] typename Stats::template producer_side<> producerStats_;
     };
 
     /**
@@ -162,70 +611,122 @@ namespace lockedin
      * @brief Producer facade exposing the push API enforced by SharedQInterface.
      *        Instances are reference wrappers returned by `SPMCQ::getProducer()`.
      */
-    template <typename T> class SPMCProducer
+    template <typename T, detail::StatsPolicy Stats> class SPMCProducer
     {
     public:
         using elem = SPMCQEntry<T>;
         /**
          * @brief Enqueues an item by copy.
-         * @return true if successful, false if buffer is full.
+         * @return true if successful, false if a reliable consumer still needs the oldest slot.
          */
         bool push(const T& item)
         {
-            const auto nxtWriteIdx_nowrap = (lWriteIdx + 1);
-            const auto nxtVersion =
-                lVersion + static_cast<decltype(lVersion)>(nxtWriteIdx_nowrap == capacity_);
-            const auto nxtWriteIdx = nxtWriteIdx_nowrap & (capacity_ - 1);
-
-            queue_.mWriteIndex.store(nxtWriteIdx,
-                                     std::memory_order_release); // update view for writers
-
-            queue_.items_[lWriteIdx] = elem{item, lVersion}; // copy into buffer
-
-            queue_.mReadIndex.store(nxtWriteIdx,
-                                    std::memory_order_release); // update view for readers
-
-            lWriteIdx = nxtWriteIdx;
-            lVersion = nxtVersion;
-            return true;
+            return publish(item);
         }
 
         /**
          * @brief Enqueues an item by move.
-         * @return true if successful, false if buffer is full.
+         * @return true if successful, false if a reliable consumer still needs the oldest slot.
          */
         bool push(T&& item)
         {
-            const auto nxtWriteIdx_nowrap = (lWriteIdx + 1);
-            const auto nxtVersion =
-                lVersion + static_cast<decltype(lVersion)>(nxtWriteIdx_nowrap == capacity_);
-            const auto nxtWriteIdx = nxtWriteIdx_nowrap & (capacity_ - 1);
+            return publish(std::move(item));
+        }
+
+        /**
+         * @brief Enqueues an item by copy under `tag` (see "Topic filtering").
+         * @return true if successful, false if a reliable consumer still needs the oldest slot.
+         */
+        bool push(const T& item, std::uint64_t tag)
+        {
+            return publish(item, tag);
+        }
+
+        /**
+         * @brief Enqueues an item by move under `tag`.
+         * @return true if successful, false if a reliable consumer still needs the oldest slot.
+         */
+        bool push(T&& item, std::uint64_t tag)
+        {
+            return publish(std::move(item), tag);
+        }
+
+    private:
+        friend class SPMCQ<T, Stats>;
+
+        explicit constexpr SPMCProducer(SPMCQ<T, Stats>& queue) noexcept
+            : queue_{queue}, capacity_{queue.capacity_}
+        {
+        }
+
+        template <typename U> bool publish(U&& item, std::uint64_t tag = 0)
+        {
+            if ((lSequence >= cachedGating_ + capacity_ ||
+                 queue_.registryEpoch_.load(std::memory_order_relaxed) != seenEpoch_) &&
+                !refreshGating())
+            {
+                queue_.producerStats_.onFull();
+                return false; // a reliable consumer still needs the oldest slot
+            }
+
+            const auto writeIdx = static_cast<size_t>(lSequence & (capacity_ - 1));
+            const auto nxtWriteIdx = (writeIdx + 1) & (capacity_ - 1);
+            elem& slot = queue_.items_[writeIdx];
 
             queue_.mWriteIndex.store(nxtWriteIdx,
                                      std::memory_order_release); // update view for writers
 
-            queue_.items_[lWriteIdx] = elem{std::move(item), lVersion}; // copy into buffer
+            // Seqlock write: readers still copying the old message see the stamp change.
+            slot.version.store(elem::writing, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.data = std::forward<U>(item);
+            slot.tag.store(tag, std::memory_order_relaxed);
+            slot.version.store(elem::stamp(lSequence), std::memory_order_release);
 
             queue_.mReadIndex.store(nxtWriteIdx,
                                     std::memory_order_release); // update view for readers
+            queue_.mSequence.store(++lSequence, std::memory_order_release);
 
-            lWriteIdx = nxtWriteIdx;
-            lVersion = nxtVersion;
+            queue_.producerStats_.onPush([this] { return retained(); });
             return true;
         }
 
-    private:
-        friend class SPMCQ<T>;
+        /**
+         * @brief Rescans the reliable consumers' cursors; slow path only.
+         * @return true if the next slot may be overwritten.
+         */
+        bool refreshGating() noexcept
+        {
+            std::uint64_t epoch = 0;
+            do
+            {
+                epoch = queue_.registryEpoch_.load(std::memory_order_acquire);
+                // Pairs with the seq_cst registration: either we see the new cursor, or a tail
+                // join sees our latest sequence and starts after it.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                cachedGating_ = queue_.minimumCursor(lSequence);
+                queue_.gatingFloor_.store(cachedGating_, std::memory_order_relaxed);
+                // Pairs with SPMCQ::secure(): a join that read the old floor bumped the epoch.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            } while (queue_.registryEpoch_.load(std::memory_order_relaxed) != epoch);
+            seenEpoch_ = epoch;
+            queue_.registryAck_.store(epoch, std::memory_order_release);
+            return lSequence < cachedGating_ + capacity_;
+        }
 
-        explicit constexpr SPMCProducer(SPMCQ<T>& queue) noexcept
-            : queue_{queue}, capacity_{queue.capacity_}
+        /**
+         * @brief Retained messages after a push: the ring only fills up once.
+         */
+        [[nodiscard]] size_t retained() const noexcept
         {
+            return lSequence < capacity_ ? static_cast<size_t>(lSequence) : capacity_;
         }
 
-        SPMCQ<T>& queue_;
+        SPMCQ<T, Stats>& queue_;
         const size_t capacity_;
-        alignas(detail::cacheline_size) size_t lWriteIdx{0};
-        alignas(detail::cacheline_size) uint32_t lVersion{0};
+        alignas(detail::cacheline_size) std::uint64_t lSequence{0}; ///< next sequence to publish
+        std::uint64_t cachedGating_{0}; ///< last seen minimum reliable cursor
+        std::uint64_t seenEpoch_{0};    ///< registry epoch `cachedGating_` accounts for
     };
 
     /**
@@ -233,12 +734,40 @@ namespace lockedin
      * @brief Consumer facade exposing the pop API enforced by SharedQInterface.
      *        Instances can only be obtained through `SPMCQ::getConsumer()`.
      */
-    template <typename T> class SPMCConsumer
+    template <typename T, detail::StatsPolicy Stats> class SPMCConsumer
     {
     public:
         using elem = SPMCQEntry<T>;
         SPMCConsumer() = default;
 
+        /**
+         * @brief Copies the read position; a reliable consumer registers its own cursor there.
+         * @throws std::runtime_error if copying a reliable consumer and the registry is full.
+         */
+        SPMCConsumer(const SPMCConsumer& other)
+            : queue_{other.queue_}, capacity_{other.capacity_}, lSequence{other.lSequence}
+        {
+            if (other.gating_ != nullptr)
+            {
+                gating_ = &queue_.registerCursor(other.position());
+                queue_.secure(*this, false); // a rescan in flight may have missed the new slot
+            }
+        }
+
+        SPMCConsumer(SPMCConsumer&& other) noexcept
+            : queue_{other.queue_}, capacity_{other.capacity_}, lSequence{other.lSequence},
+              consumerStats_{other.consumerStats_}, gating_{std::exchange(other.gating_, nullptr)}
+        {
+        }
+
+        SPMCConsumer& operator=(const SPMCConsumer&) = delete;
+        SPMCConsumer& operator=(SPMCConsumer&&) = delete;
+
+        ~SPMCConsumer()
+        {
+            detach();
+        }
+
         /**
          * @brief Dequeues an item. Raises an exception if consumer is overlapped
          * @return true if successful, exception if consumer is overlapped by producer, false if
@@ -246,42 +775,238 @@ namespace lockedin
          */
         bool pop(T& item)
         {
-            if (lReadIdx == queue_.mReadIndex.load(std::memory_order_acquire))
+            if (lSequence >= queue_.mSequence.load(std::memory_order_acquire))
+            {
+                consumerStats_.onEmpty();
                 return false; // empty
+            }
+
+            // have to copy, move would invalidate other readers
+            if (!queue_.copyIfCurrent(lSequence, item))
+                overrun(lSequence);
 
-            const elem& val = queue_.items_[lReadIdx];
-            if (val.version != lVersion)
-                throw std::runtime_error("consumer overlapped at index " +
-                                         std::to_string(lReadIdx)); // reader too slow
+            ++lSequence;
+            if (gating_ != nullptr)
+                gating_->cursor.store(lSequence, std::memory_order_release); // slot is free
+            consumerStats_.onPop();
+            return true;
+        }
 
-            item = val.data; // have to copy, move would invalidate other readers
+        /**
+         * @brief Consumes up to `max` ready messages without copying them.
+         * @param fn Called as `fn(SPMCView<T>, std::uint64_t firstSequence)` once per contiguous
+         *           run (at most twice).
+         * @return the number of messages consumed (0 if empty).
+         * @throws std::runtime_error if the producer overwrote the batch while `fn` ran.
+         */
+        template <typename Fn>
+        size_t readBatch(Fn&& fn, size_t max = std::numeric_limits<size_t>::max())
+        {
+            const auto published = queue_.mSequence.load(std::memory_order_acquire);
+            if (max == 0)
+                return 0;
+            if (lSequence >= published)
+            {
+                consumerStats_.onEmpty();
+                return 0; // empty
+            }
+
+            const auto first = lSequence;
+            const auto available = published - first;
+            const auto count = static_cast<size_t>(available < max ? available : max);
+            const elem& oldest = queue_.items_[static_cast<size_t>(first & (capacity_ - 1))];
+            if (oldest.version.load(std::memory_order_acquire) != elem::stamp(first))
+                overrun(first);
+
+            const auto startIdx = static_cast<size_t>(first & (capacity_ - 1));
+            const auto head = count < capacity_ - startIdx ? count : capacity_ - startIdx;
+            fn(SPMCView<T>(&queue_.items_[startIdx], head), first);
+            if (head < count)
+                fn(SPMCView<T>(&queue_.items_[0], count - head), first + head);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (oldest.version.load(std::memory_order_relaxed) != elem::stamp(first))
+                overrun(first);
+
+            lSequence += count;
+            if (gating_ != nullptr)
+                gating_->cursor.store(lSequence, std::memory_order_release); // slots are free
+            consumerStats_.onPop(count);
+            return count;
+        }
 
-            const auto nxtReadIdx_nowrap = (lReadIdx + 1);
-            const auto nxtVersion =
-                lVersion + static_cast<decltype(lVersion)>(nxtReadIdx_nowrap == capacity_);
-            lReadIdx = nxtReadIdx_nowrap & (capacity_ - 1);
-            lVersion = nxtVersion;
+        /**
+         * @brief Calls `fn(const T&)` on the next message without consuming or copying it.
+         * @return true if a message was inspected, false if empty.
+         * @throws std::runtime_error if the message was overwritten while `fn` ran.
+         */
+        template <typename Fn> bool peek(Fn&& fn)
+        {
+            if (lSequence >= queue_.mSequence.load(std::memory_order_acquire))
+            {
+                consumerStats_.onEmpty();
+                return false; // empty
+            }
+
+            const elem& slot = queue_.items_[static_cast<size_t>(lSequence & (capacity_ - 1))];
+            const auto expected = elem::stamp(lSequence);
+            if (slot.version.load(std::memory_order_acquire) != expected)
+                overrun(lSequence);
+            fn(static_cast<const T&>(slot.data));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.version.load(std::memory_order_relaxed) != expected)
+                overrun(lSequence);
             return true;
         }
 
+        /**
+         * @brief Consumes the messages, up to `max`, before the next one whose tag passes
+         *        `match(tag)`, reading only their stamp lines. Stops at a matching message
+         *        without consuming it.
+         * @return the number of messages skipped.
+         * @throws std::runtime_error if consumer is overlapped by producer.
+         */
+        template <typename Match>
+        size_t skipNonMatching(Match&& match, size_t max = std::numeric_limits<size_t>::max())
+        {
+            const auto first = lSequence;
+            seekMatch(match, max);
+            return static_cast<size_t>(lSequence - first);
+        }
+
+        /**
+         * @brief Dequeues the next message whose tag passes `match(tag)`, consuming the
+         *        non-matching ones before it without copying them.
+         * @param maxScan Most messages inspected per call, to bound its latency.
+         * @return true if `item` was filled; false if no published message (within `maxScan`)
+         *         matched.
+         * @throws std::runtime_error if consumer is overlapped by producer.
+         */
+        template <typename Match>
+        bool popMatching(T& item, Match&& match,
+                         size_t maxScan = std::numeric_limits<size_t>::max())
+        {
+            return seekMatch(match, maxScan) && pop(item);
+        }
+
+        /**
+         * @brief Dequeues an item and reports the sequence it was published under.
+         */
+        bool pop(T& item, std::uint64_t& sequence)
+        {
+            sequence = lSequence;
+            return pop(item);
+        }
+
+        /**
+         * @brief Skips to the producer's current position (e.g. after being overlapped).
+         */
         void respawn()
         {
-            lReadIdx = queue_.mReadIndex.load(std::memory_order_relaxed);
-            lVersion = queue_.items_[lReadIdx].version;
+            seek(queue_.mSequence.load(std::memory_order_acquire));
+            if (gating_ != nullptr)
+                gating_->cursor.store(position(), std::memory_order_release);
+        }
+
+        /**
+         * @brief Leaves the reliable registry; the producer stops waiting for this consumer,
+         *        which keeps reading as a lossy consumer. No-op if already lossy.
+         */
+        void detach() noexcept
+        {
+            if (gating_ != nullptr)
+                std::exchange(gating_, nullptr)
+                    ->cursor.store(detail::SPMCGatingCursor::vacant, std::memory_order_release);
+        }
+
+        /**
+         * @brief Global sequence of the next message this consumer will read.
+         */
+        [[nodiscard]] std::uint64_t position() const noexcept
+        {
+            return lSequence;
+        }
+
+        /**
+         * @brief true if the producer waits for this consumer instead of lapping it.
+         */
+        [[nodiscard]] bool reliable() const noexcept
+        {
+            return gating_ != nullptr;
+        }
+
+        /**
+         * @brief Snapshot of this consumer's counters; safe to call from any thread.
+         */
+        [[nodiscard]] QueueStatsSnapshot stats() const noexcept
+            requires Stats::enabled
+        {
+            QueueStatsSnapshot snapshot;
+            consumerStats_.collect(snapshot);
+            return snapshot;
         }
 
     private:
-        friend class SPMCQ<T>;
+        friend class SPMCQ<T, Stats>;
 
-        explicit constexpr SPMCConsumer(SPMCQ<T>& queue) noexcept
+        explicit constexpr SPMCConsumer(SPMCQ<T, Stats>& queue) noexcept
             : queue_{queue}, capacity_{queue.capacity_}
         {
         }
 
-        SPMCQ<T>& queue_{};
+        void seek(std::uint64_t sequence) noexcept
+        {
+            lSequence = sequence;
+        }
+
+        // Skips non-matching published messages, up to `max`.
+        // Returns true if it stopped at a matching one, which stays unconsumed.
+        template <typename Match> bool seekMatch(Match& match, size_t max)
+        {
+            const auto published = queue_.mSequence.load(std::memory_order_acquire);
+            const auto first = lSequence;
+            bool found = false;
+            std::uint64_t tag = 0;
+            for (size_t scanned = 0; lSequence < published && scanned < max; ++scanned)
+            {
+                if (!queue_.tagIfCurrent(lSequence, tag))
+                    overrun(lSequence);
+                if ((found = match(tag)))
+                    break;
+                ++lSequence;
+            }
+
+            if (lSequence != first && gating_ != nullptr)
+                gating_->cursor.store(lSequence, std::memory_order_release); // slots are free
+            return found;
+        }
+
+        [[noreturn]] void overrun(std::uint64_t sequence)
+        {
+            consumerStats_.onOverrun();
+            throw std::runtime_error("consumer overlapped at sequence " +
+                                     std::to_string(sequence)); // reader too slow
+        }
+
+        // The slot already holds our start. When joining at the tail, re-read the producer and
+        // start there: a push racing the registration may not have seen our cursor.
+        void attach(detail::SPMCGatingCursor& slot, bool followTail)
+        {
+            gating_ = &slot;
+            if (!followTail)
+                return;
+            const auto tail = queue_.mSequence.load(std::memory_order_seq_cst);
+            if (tail > position())
+            {
+                seek(tail);
+                gating_->cursor.store(position(), std::memory_order_release);
+            }
+        }
+
+        SPMCQ<T, Stats>& queue_{};
         const size_t capacity_;
-        // Local cursors kept for documentation purposes; real implementation will advance them.
-        alignas(detail::cacheline_size) size_t lReadIdx{0};
-        alignas(detail::cacheline_size) uint32_t lVersion{0};
+        alignas(detail::cacheline_size) std::uint64_t lSequence{0}; ///< next sequence to read
+        [[no_unique_address]] typename Stats::consumer_side consumerStats_;
+        detail::SPMCGatingCursor* gating_{nullptr}; ///< registry slot when reliable
     };
 } // namespace lockedin
@@ -0,0 +1,346 @@
+/**
+ * @file spmc_relay.hpp
+ * @brief **Per-socket replicas of an `SPMCQ`**, so consumers on remote NUMA nodes read a ring
+ *        in their own socket's memory instead of pulling every slot across the interconnect.
+ *
+ * ```text
+ *                 socket 0 (home)                     socket 1
+ *   producer --> primary SPMCQ --> local consumers
+ *                      |
+ *                      +--> relay thread (pinned to socket 1) --> replica SPMCQ --> consumers
+ * ```
+ *
+ * One relay thread per remote socket consumes the primary ring and republishes every message
+ * into a replica ring owned by that socket; consumers on the home socket read the primary
+ * directly. Each message therefore crosses the interconnect once per remote socket, however
+ * many consumers live there.
+ *
+ * ## Placement
+ * The topology defaults to `CpuTopology::detect()` and the home socket to the one the
+ * constructing thread runs on, which should be the producer's. Each relay thread pins itself
+ * to its socket and constructs the replica there, so first-touch allocation puts the replica
+ * in that socket's memory. `getConsumer()` attaches to the ring of the calling thread's
+ * current socket; pin consumers before calling it (or pass the socket explicitly).
+ *
+ * ## Delivery
+ * * With `SPMCMode::Reliable` each relay registers as a reliable consumer of the primary, so
+ *   the producer waits for the slowest relay instead of lapping it, and replicas lose nothing
+ *   as long as their own consumers keep up.
+ * * With `SPMCMode::Lossy` (the default, like `SPMCQ` itself) the producer never waits; a relay
+ *   that gets lapped skips to the primary's tail and counts the loss in `overruns()`.
+ *
+ * Relays join the primary at its tail when the relay is constructed. While no relay is lapped,
+ * a replica carries the same messages, in order, with sequence = primary sequence minus the
+ * primary's sequence at construction. A replica's own overruns and reliable consumers work
+ * exactly as on any `SPMCQ`. Relay threads poll with the `Wait` policy. Neither the primary's
+ * producer nor a replica's consumers notify them, so the policy must poll: `BlockingWait` is
+ * rejected at compile time, as it would park a relay until `stop()`.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/cpu_topology.hpp>
+#include <lockedin/spmc_queue.hpp>
+#include <lockedin/wait_strategy.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lockedin
+{
+    /**
+     * @tparam T    Element type of the primary ring.
+     * @tparam Wait Idle policy of the relay threads (see `wait_strategy.hpp`); a polling one.
+     *
+     * @class SPMCRelay
+     * @brief Replicates one `SPMCQ` into a ring per remote socket.
+     */
+    template <typename T, typename Wait = BackoffWait<>>
+        requires detail::PollingWaitStrategy<Wait>
+    class SPMCRelay
+    {
+    public:
+        /**
+         * @param primary         Ring the producer publishes to; must outlive the relay.
+         * @param topology        Sockets to serve.
+         * @param home            Socket of the primary ring (and producer).
+         * @param mode            How relays read the primary, see "Delivery".
+         * @param replicaCapacity Capacity of each replica; 0 for the primary's capacity.
+         * @param maxReliableConsumers Registry size of each replica.
+         * @throws std::logic_error if `home` is not a socket of `topology` or the capacity is
+         *         invalid.
+         * @throws std::runtime_error if `mode` is reliable and the primary's registry is full.
+         * @throws whatever starting a relay thread or building a replica threw; relay threads
+         *         already started are stopped and joined first.
+         */
+        SPMCRelay(SPMCQ<T>& primary, CpuTopology topology, std::size_t home,
+                  SPMCMode mode = SPMCMode::Lossy, std::size_t replicaCapacity = 0,
+                  std::size_t maxReliableConsumers = 8)
+            : primary_{primary}, topology_{std::move(topology)}, home_{home}
+        {
+            if (home_ >= topology_.sockets())
+                throw std::logic_error("Home socket is not part of the topology.");
+            const auto capacity = replicaCapacity != 0 ? replicaCapacity : primary.capacity();
+            if (capacity < 2 || !std::has_single_bit(capacity))
+                throw std::logic_error("Capacity must be a power of 2, and greater than 1.");
+
+            // Claim every relay's cursor before any thread exists, so a full registry throws
+            // with nothing to clean up but the consumers already claimed.
+            relays_.resize(topology_.sockets());
+            for (std::size_t s = 0; s < topology_.sockets(); ++s)
+                if (s != home_)
+                    relays_[s] =
+                        std::make_unique<Relay>(primary_.getConsumer(SPMCJoin::Tail, mode));
+
+            std::latch built(static_cast<std::ptrdiff_t>(topology_.sockets() - 1));
+            try
+            {
+                for (std::size_t s = 0; s < topology_.sockets(); ++s)
+                {
+                    if (s == home_)
+                        continue;
+                    relays_[s]->thread = std::thread(
+                        [this, r = relays_[s].get(), s, capacity, maxReliableConsumers, &built]
+                        {
+                            try
+                            {
+                                topology_.pinCurrentThread(s);
+                                r->replica =
+                                    std::make_unique<SPMCQ<T>>(capacity, maxReliableConsumers);
+                            }
+                            catch (...)
+                            {
+                                r->failure = std::current_exception();
+                            }
+                            built.count_down();
+                            if (!r->failure)
+                                run(*r);
+                        });
+                }
+            }
+            catch (...)
+            {
+                stop(); // threads already started count down and exit; `built` outlives them
+                throw;
+            }
+
+            built.wait();
+            for (const auto& relay : relays_)
+            {
+                if (relay != nullptr && relay->failure)
+                {
+                    stop();
+                    std::rethrow_exception(relay->failure);
+                }
+            }
+        }
+
+        /**
+         * @brief Detects the topology and takes the calling thread's socket as home.
+         */
+        explicit SPMCRelay(SPMCQ<T>& primary, SPMCMode mode = SPMCMode::Lossy)
+            : SPMCRelay(primary, CpuTopology::detect(), mode)
+        {
+        }
+
+        SPMCRelay(const SPMCRelay&) = delete;
+        SPMCRelay& operator=(const SPMCRelay&) = delete;
+        SPMCRelay(SPMCRelay&&) = delete;
+        SPMCRelay& operator=(SPMCRelay&&) = delete;
+
+        ~SPMCRelay()
+        {
+            stop();
+        }
+
+        /* ------------------------------------------------------------------
+         * Consumer API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Consumer of the ring on the calling thread's current socket.
+         * @throws std::runtime_error if `mode` is reliable and that ring's registry is full.
+         */
+        [[nodiscard]] SPMCConsumer<T> getConsumer(SPMCJoin where = SPMCJoin::Tail,
+                                                  SPMCMode mode = SPMCMode::Lossy) const
+        {
+            return ring(topology_.currentSocket()).getConsumer(where, mode);
+        }
+
+        /**
+         * @brief Consumer of the ring serving `socket`.
+         */
+        [[nodiscard]] SPMCConsumer<T> getConsumer(std::size_t socket, SPMCJoin where,
+                                                  SPMCMode mode = SPMCMode::Lossy) const
+        {
+            return ring(socket).getConsumer(where, mode);
+        }
+
+        /**
+         * @brief The primary for the home socket, the replica for any other.
+         */
+        [[nodiscard]] SPMCQ<T>& ring(std::size_t socket) const
+        {
+            if (socket == home_)
+                return primary_;
+            return *relays_.at(socket)->replica;
+        }
+
+        /* ------------------------------------------------------------------
+         * Status API
+         * ----------------------------------------------------------------*/
+
+        [[nodiscard]] const CpuTopology& topology() const noexcept
+        {
+            return topology_;
+        }
+
+        [[nodiscard]] std::size_t home() const noexcept
+        {
+            return home_;
+        }
+
+        /**
+         * @brief Messages republished into the replica of `socket` (0 for the home socket).
+         */
+        [[nodiscard]] std::uint64_t relayed(std::size_t socket) const noexcept
+        {
+            return socket == home_ ? 0 : relays_[socket]->relayed.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Times the relay of `socket` was lapped by the primary producer (lossy only).
+         */
+        [[nodiscard]] std::uint64_t overruns(std::size_t socket) const noexcept
+        {
+            return socket == home_ ? 0 : relays_[socket]->overruns.load(std::memory_order_relaxed);
+        }
+
+        /* ------------------------------------------------------------------
+         * Lifecycle
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Stops and joins the relay threads; replicas stay readable. Idempotent.
+         * Messages already in the primary are relayed first, unless a replica is blocked on
+         * a reliable consumer of its own.
+         */
+        void stop()
+        {
+            if (stopping_.exchange(true, std::memory_order_acq_rel))
+                return;
+            for (auto& relay : relays_)
+                if (relay != nullptr)
+                    relay->wait.notify();
+            for (auto& relay : relays_)
+                if (relay != nullptr && relay->thread.joinable())
+                    relay->thread.join();
+        }
+
+    private:
+        SPMCRelay(SPMCQ<T>& primary, CpuTopology topology, SPMCMode mode)
+            : SPMCRelay(primary, topology, topology.currentSocket(), mode)
+        {
+        }
+
+        static constexpr std::size_t batch = 256; ///< messages per poll of the primary
+
+        struct Relay
+        {
+            explicit Relay(SPMCConsumer<T> in) : input{std::move(in)}
+            {
+            }
+
+            SPMCConsumer<T> input;             ///< cursor into the primary
+            std::unique_ptr<SPMCQ<T>> replica; ///< built on the relay's socket
+            std::exception_ptr failure;        ///< building `replica` threw
+            alignas(detail::cacheline_size) Wait wait;
+            std::atomic<std::uint64_t> relayed{0};
+            std::atomic<std::uint64_t> overruns{0};
+            std::thread thread;
+        };
+
+        // Pushes into the replica, waiting while its reliable consumers hold the ring full;
+        // gives up once `stop()` has been called.
+        bool forward(Relay& self, SPMCProducer<T>& out, const T& item)
+        {
+            while (!out.push(item))
+            {
+                if (stopping_.load(std::memory_order_acquire))
+                    return false;
+                self.wait.idle([&] { return !self.replica->full(); });
+            }
+            return true;
+        }
+
+        void run(Relay& self)
+        {
+            auto out = self.replica->getProducer();
+            const auto ready = [&]
+            {
+                return primary_.sequence() > self.input.position() ||
+                       stopping_.load(std::memory_order_acquire);
+            };
+            T item{};
+            bool stopping = false;
+
+            while (true)
+            {
+                std::size_t moved = 0;     // taken from the primary
+                std::size_t forwarded = 0; // of which made it into the replica
+                if (self.input.reliable())
+                {
+                    // The producer cannot overwrite these slots, so relay them without a copy.
+                    moved = self.input.readBatch(
+                        [&](SPMCView<T> view, std::uint64_t)
+                        {
+                            for (const T& m : view)
+                                forwarded += forward(self, out, m);
+                        },
+                        batch);
+                }
+                else
+                {
+                    try
+                    {
+                        for (; moved < batch && self.input.pop(item); ++moved)
+                            forwarded += forward(self, out, item);
+                    }
+                    catch (const std::runtime_error&)
+                    {
+                        self.overruns.fetch_add(1, std::memory_order_relaxed);
+                        self.input.respawn();
+                    }
+                }
+
+                if (moved != 0)
+                {
+                    self.relayed.fetch_add(forwarded, std::memory_order_relaxed);
+                    self.wait.reset();
+                }
+                else if (stopping)
+                    break; // drained after stop()
+                else if (stopping_.load(std::memory_order_acquire))
+                    stopping = true;
+                else
+                    self.wait.idle(ready);
+            }
+        }
+
+        SPMCQ<T>& primary_;
+        CpuTopology topology_;
+        std::size_t home_;
+        std::vector<std::unique_ptr<Relay>> relays_; ///< null for the home socket
+        alignas(detail::cacheline_size) std::atomic<bool> stopping_{false};
+    };
+}
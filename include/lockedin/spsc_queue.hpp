@@ -18,51 +18,148 @@
  * ## Complexity
  * * `push()` – *O(1)* / wait‑free (returns false immediately if full).
  * * `pop()`  – *O(1)* / wait‑free (returns false immediately if empty).
+ * * `pushBulk()` / `popBulk()` – *O(n)* / wait‑free; one index handshake per batch and, for
+ *   trivially copyable `T`, at most two `memcpy`s split at the wrap point (see
+ *   `bulk_copy.hpp`).
  *
  * ## Memory ordering
  * * Producer        – `load(acquire)` on read index (to ensure space),
  * `store(release)` on write index (to commit data).
  * * Consumer        – `load(acquire)` on write index (to ensure data visibility),
  * `store(release)` on read index (to mark slot free).
+ *
+ * ## Lazy publication (opt-in)
+ * Every eager `push()`/`pop()` ends with a release store of its own cursor, which invalidates
+ * the line the other side keeps polling. With `Publish = LazyPublish<K>` both sides work on a
+ * private copy of their cursor and a cached copy of the other side's:
+ *
+ * * the producer publishes `writeIdx_` every `K` pushes, on `flush()`, and whenever it finds
+ *   the ring full;
+ * * the consumer releases slots every `K` pops, on `release()`, and whenever it finds the ring
+ *   empty;
+ * * each side reloads the other's cursor only when its cached copy says full/empty.
+ *
+ * Cross-core traffic drops to about one line transfer per `K` elements each way, at the cost
+ * of up to `K - 1` elements of latency until the producer calls `flush()`. A side that runs out
+ * of work always hands back what it holds, so the queue cannot stall. `size()`, `empty()` and
+ * `full()` reflect the published cursors.
+ *
+ * ## Storage
+ * Slots live in a plain heap array (`HeapStorage`). With `MirrorStorage` (see
+ * `mirror_buffer.hpp`) the ring is mapped twice back to back, so bulk copies run in one piece
+ * and `readable()`/`consume()` give zero-copy access to every queued item as a single span.
+ *
+ * ## Telemetry
+ * The `Stats` policy (see `queue_stats.hpp`) defaults to `NoStats`, which compiles to nothing.
+ * With `QueueStats<>` the producer counters share the `writeIdx_` cache line and the consumer
+ * counters share the `readIdx_` line; read them from any thread via `stats()`.
  */
 
 #pragma once
 
 #include <lockedin/abstract_queue.hpp>
+#include <lockedin/bulk_copy.hpp>
+#include <lockedin/queue_stats.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <bitset>
 #include <climits>
 #include <cstddef>
 #include <memory>
 #include <new>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 namespace lockedin
 {
+    /**
+     * @brief Publication policy: every push/pop is visible to the other side immediately.
+     */
+    struct EagerPublish
+    {
+        static constexpr std::size_t batch = 1;
+    };
+
+    /**
+     * @brief Publication policy: cursors are published every `K` operations or on demand.
+     */
+    template <std::size_t K> struct LazyPublish
+    {
+        static_assert(K >= 1, "LazyPublish needs a batch of at least 1.");
+        static constexpr std::size_t batch = K;
+    };
+
+    /**
+     * @brief Storage policy: slots in a heap array; a batch crossing the wrap point is split.
+     */
+    struct HeapStorage
+    {
+        static constexpr bool contiguous = false;
+
+        template <typename T> class buffer
+        {
+        public:
+            explicit buffer(std::size_t capacity) : items_{std::make_unique<T[]>(capacity)}
+            {
+            }
+
+            [[nodiscard]] T* data() const noexcept
+            {
+                return items_.get();
+            }
+
+        private:
+            std::unique_ptr<T[]> items_;
+        };
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief One side's private cursor and its cached copy of the other side's (lazy
+         *        publication only). The distance from the published cursor is the backlog.
+         */
+        struct LazyCursor
+        {
+            std::size_t own{0};
+            std::size_t cachedOther{0};
+        };
+
+        struct NoLazyCursor
+        {
+        };
+    } // namespace detail
 
     /**
      * @tparam T            Element type.
+     * @tparam Stats        Telemetry policy (`NoStats` or `QueueStats<>`).
+     * @tparam Publish      `EagerPublish` or `LazyPublish<K>`.
+     * @tparam Storage      `HeapStorage` or `MirrorStorage`.
      *
      * @class SPSCQ
      * @brief Lock‑free, wait‑free ring buffer for one producer and one consumer.
      */
-    template <typename T> class SPSCQ : public AbstractQ<T, SPSCQ<T>>
+    template <typename T, detail::StatsPolicy Stats = NoStats, typename Publish = EagerPublish,
+              typename Storage = HeapStorage>
+    class SPSCQ : public AbstractQ<T, SPSCQ<T, Stats, Publish, Storage>>
     {
+        static constexpr bool lazy = Publish::batch > 1;
+
     public:
         /**
          * @brief Construct with a specific capacity.
          * @param capacity Must be a **power of 2** (e.g., 64, 1024) to allow
          * efficient bitwise wrapping.
-         * @throws std::logic_error if capacity is invalid (<2 or not power of 2).
+         * @throws std::logic_error if capacity is invalid (<2 or not power of 2), or with
+         *         `LazyPublish<K>` not greater than `K`.
          */
         explicit SPSCQ(size_t capacity)
-            : AbstractQ<T, SPSCQ<T>>(capacity), capacity_{capacity},
-              items_{std::make_unique<T[]>(capacity)}
+            : AbstractQ<T, SPSCQ<T, Stats, Publish, Storage>>(capacity), capacity_{capacity},
+              storage_{checked(capacity)}, items_{storage_.data()}
         {
-            if (capacity < 2 || std::bitset<sizeof(size_t) * CHAR_BIT>(capacity).count() != 1)
-                throw std::logic_error("Capacity must be a power of 2, and greater than 1.");
         }
 
         SPSCQ(const SPSCQ&) = delete;
@@ -82,18 +179,7 @@ namespace lockedin
          */
         bool push(const T& item)
         {
-            const auto writeIdx = writeIdx_.load(std::memory_order_relaxed);
-            const auto readIdx = readIdx_.load(std::memory_order_acquire);
-
-            const auto nextWriteIdx = (writeIdx + 1) & (capacity_ - 1);
-
-            if (nextWriteIdx == readIdx)
-                return false; // Full
-
-            items_[writeIdx] = item;
-            writeIdx_.store(nextWriteIdx, std::memory_order_release);
-
-            return true;
+            return emplace(item);
         }
 
         /**
@@ -102,18 +188,17 @@ namespace lockedin
          */
         bool push(T&& item)
         {
-            const auto writeIdx = writeIdx_.load(std::memory_order_relaxed);
-            const auto readIdx = readIdx_.load(std::memory_order_acquire);
-
-            const auto nextWriteIdx = (writeIdx + 1) & (capacity_ - 1);
-
-            if (nextWriteIdx == readIdx)
-                return false; // Full
-
-            items_[writeIdx] = std::move(item);
-            writeIdx_.store(nextWriteIdx, std::memory_order_release);
+            return emplace(std::move(item));
+        }
 
-            return true;
+        /**
+         * @brief Makes every pushed item visible to the consumer (`LazyPublish` only; eager
+         *        queues publish on every push).
+         */
+        void flush() noexcept
+        {
+            if constexpr (lazy)
+                publishWrites();
         }
 
         /* ------------------------------------------------------------------
@@ -127,20 +212,147 @@ namespace lockedin
          */
         bool pop(T& item)
         {
+            if constexpr (lazy)
+                return lazyPop(item);
+
             const auto readIdx = readIdx_.load(std::memory_order_relaxed);
             const auto writeIdx = writeIdx_.load(std::memory_order_acquire);
 
             if (readIdx == writeIdx)
+            {
+                consumerStats_.onEmpty();
                 return false; // Empty
+            }
 
             item = std::move(items_[readIdx]);
 
             const auto nextReadIdx = (readIdx + 1) & (capacity_ - 1);
             readIdx_.store(nextReadIdx, std::memory_order_release);
+            consumerStats_.onPop();
 
             return true;
         }
 
+        /**
+         * @brief Hands every consumed slot back to the producer (`LazyPublish` only; eager
+         *        queues release on every pop).
+         */
+        void release() noexcept
+        {
+            if constexpr (lazy)
+                releaseReads();
+        }
+
+        /**
+         * @brief Enqueues up to `count` items by copy with a single publish.
+         * @tparam Store `BulkStore::Streaming` writes trivially copyable items with
+         *               non-temporal stores (large batches only).
+         * @return number of items enqueued; 0 if the buffer is full.
+         */
+        template <BulkStore Store = BulkStore::Cached>
+        size_t pushBulk(const T* items, size_t count)
+        {
+            const auto writeIdx = writeCursor();
+            const auto readIdx = readIdx_.load(std::memory_order_acquire);
+            const auto n = std::min(count, (readIdx - writeIdx - 1) & (capacity_ - 1));
+            if (n == 0)
+            {
+                flush();
+                if (count != 0)
+                    producerStats_.onFull();
+                return 0;
+            }
+
+            if constexpr (Storage::contiguous)
+                detail::bulkStore<Store>(&items_[writeIdx], items, n); // runs into the mirror
+            else
+            {
+                const auto first = std::min(n, capacity_ - writeIdx);
+                detail::bulkStore<Store>(&items_[writeIdx], items, first);
+                detail::bulkStore<Store>(&items_[0], items + first, n - first);
+            }
+            if constexpr (Store == BulkStore::Streaming && std::is_trivially_copyable_v<T>)
+                detail::streamFence();
+
+            const auto nextWriteIdx = (writeIdx + n) & (capacity_ - 1);
+            if constexpr (lazy)
+                producer_ = {nextWriteIdx, readIdx}; // a batch publishes everything
+            writeIdx_.store(nextWriteIdx, std::memory_order_release);
+            producerStats_.onPush([&] { return (nextWriteIdx - readIdx) & (capacity_ - 1); }, n);
+            return n;
+        }
+
+        /**
+         * @brief Dequeues up to `max` items into `out` with a single release of their slots.
+         * @return number of items dequeued; 0 if the buffer is empty.
+         */
+        size_t popBulk(T* out, size_t max)
+        {
+            const auto readIdx = readCursor();
+            const auto writeIdx = writeIdx_.load(std::memory_order_acquire);
+            const auto n = std::min(max, (writeIdx - readIdx) & (capacity_ - 1));
+            if (n == 0)
+            {
+                release();
+                consumerStats_.onEmpty();
+                return 0;
+            }
+
+            if constexpr (Storage::contiguous)
+                detail::bulkLoad(out, &items_[readIdx], n);
+            else
+            {
+                const auto first = std::min(n, capacity_ - readIdx);
+                detail::bulkLoad(out, &items_[readIdx], first);
+                detail::bulkLoad(out + first, &items_[0], n - first);
+            }
+            advanceRead(readIdx, writeIdx, n);
+            return n;
+        }
+
+        /**
+         * @brief Every queued item as one contiguous span, wrap point included (`MirrorStorage`
+         *        only). Consumer thread only; valid until `consume()`.
+         */
+        [[nodiscard]] std::span<T> readable()
+            requires Storage::contiguous
+        {
+            const auto readIdx = readCursor();
+            const auto writeIdx = writeIdx_.load(std::memory_order_acquire);
+            const auto n = (writeIdx - readIdx) & (capacity_ - 1);
+            if (n == 0)
+                release();
+            return {&items_[readIdx], n};
+        }
+
+        /**
+         * @brief Frees the first `n` items of `readable()` (at most its size) in one release.
+         */
+        void consume(size_t n)
+            requires Storage::contiguous
+        {
+            if (n == 0)
+                return;
+            const auto readIdx = readCursor();
+            advanceRead(readIdx, writeIdx_.load(std::memory_order_acquire), n);
+        }
+
+        /**
+         * @brief Peeks at the next item without consuming it. Consumer thread only.
+         * @return pointer to the front element, or nullptr if the buffer is empty. Valid until
+         * the next `pop()`.
+         */
+        [[nodiscard]] T* front()
+        {
+            const auto readIdx = readCursor();
+            if (readIdx == writeIdx_.load(std::memory_order_acquire))
+            {
+                release();
+                return nullptr; // Empty
+            }
+            return &items_[readIdx];
+        }
+
         /* ------------------------------------------------------------------
          * Status API
          * ----------------------------------------------------------------*/
@@ -172,14 +384,164 @@ namespace lockedin
             return (writeIdx - readIdx) & (capacity_ - 1);
         }
 
+        /**
+         * @brief Snapshot of the telemetry counters; safe to call from any thread.
+         */
+        [[nodiscard]] QueueStatsSnapshot stats() const noexcept
+            requires Stats::enabled
+        {
+            QueueStatsSnapshot snapshot;
+            producerStats_.collect(snapshot);
+            consumerStats_.collect(snapshot);
+            return snapshot;
+        }
+
     private:
+        static size_t checked(size_t capacity)
+        {
+            if (capacity < 2 || std::bitset<sizeof(size_t) * CHAR_BIT>(capacity).count() != 1)
+                throw std::logic_error("Capacity must be a power of 2, and greater than 1.");
+            // A batch that never fits would only ever publish on full/empty.
+            if (lazy && capacity <= Publish::batch)
+                throw std::logic_error("LazyPublish<K> needs a capacity greater than K.");
+            return capacity;
+        }
+
+        void advanceRead(size_t readIdx, size_t writeIdx, size_t n)
+        {
+            const auto nextReadIdx = (readIdx + n) & (capacity_ - 1);
+            if constexpr (lazy)
+                consumer_ = {nextReadIdx, writeIdx};
+            readIdx_.store(nextReadIdx, std::memory_order_release);
+            consumerStats_.onPop(n);
+        }
+
+        template <typename U> bool emplace(U&& item)
+        {
+            if constexpr (lazy)
+                return lazyPush(std::forward<U>(item));
+
+            const auto writeIdx = writeIdx_.load(std::memory_order_relaxed);
+            const auto readIdx = readIdx_.load(std::memory_order_acquire);
+
+            const auto nextWriteIdx = (writeIdx + 1) & (capacity_ - 1);
+
+            if (nextWriteIdx == readIdx)
+            {
+                producerStats_.onFull();
+                return false; // Full
+            }
+
+            items_[writeIdx] = std::forward<U>(item);
+            writeIdx_.store(nextWriteIdx, std::memory_order_release);
+            producerStats_.onPush([&] { return (nextWriteIdx - readIdx) & (capacity_ - 1); });
+
+            return true;
+        }
+
+        /* ------------------------------------------------------------------
+         * Lazy publication
+         * ----------------------------------------------------------------*/
+
+        template <typename U> bool lazyPush(U&& item)
+        {
+            const auto writeIdx = producer_.own;
+            const auto nextWriteIdx = (writeIdx + 1) & (capacity_ - 1);
+
+            if (nextWriteIdx == producer_.cachedOther)
+            {
+                producer_.cachedOther = readIdx_.load(std::memory_order_acquire);
+                if (nextWriteIdx == producer_.cachedOther)
+                {
+                    publishWrites(); // let the consumer drain what is already written
+                    producerStats_.onFull();
+                    return false; // Full
+                }
+            }
+
+            // The cursors are read before the element is written: for integral `T` that store
+            // could otherwise alias them and force a reload.
+            const auto readIdx = producer_.cachedOther;
+            const auto published = writeIdx_.load(std::memory_order_relaxed);
+            items_[writeIdx] = std::forward<U>(item);
+            producer_.own = nextWriteIdx;
+            if (((nextWriteIdx - published) & (capacity_ - 1)) >= Publish::batch)
+                writeIdx_.store(nextWriteIdx, std::memory_order_release);
+            producerStats_.onPush([&] { return (nextWriteIdx - readIdx) & (capacity_ - 1); });
+
+            return true;
+        }
+
+        bool lazyPop(T& item)
+        {
+            const auto readIdx = consumer_.own;
+
+            if (readIdx == consumer_.cachedOther)
+            {
+                consumer_.cachedOther = writeIdx_.load(std::memory_order_acquire);
+                if (readIdx == consumer_.cachedOther)
+                {
+                    releaseReads(); // let the producer reuse what is already consumed
+                    consumerStats_.onEmpty();
+                    return false; // Empty
+                }
+            }
+
+            const auto released = readIdx_.load(std::memory_order_relaxed);
+            const auto nextReadIdx = (readIdx + 1) & (capacity_ - 1);
+            item = std::move(items_[readIdx]);
+            consumer_.own = nextReadIdx;
+            if (((nextReadIdx - released) & (capacity_ - 1)) >= Publish::batch)
+                readIdx_.store(nextReadIdx, std::memory_order_release);
+            consumerStats_.onPop();
+
+            return true;
+        }
+
+        void publishWrites() noexcept
+        {
+            if (writeIdx_.load(std::memory_order_relaxed) != producer_.own)
+                writeIdx_.store(producer_.own, std::memory_order_release);
+        }
+
+        void releaseReads() noexcept
+        {
+            if (readIdx_.load(std::memory_order_relaxed) != consumer_.own)
+                readIdx_.store(consumer_.own, std::memory_order_release);
+        }
+
+        // Where the next element goes / comes from, published or not.
+        [[nodiscard]] size_t writeCursor() const noexcept
+        {
+            if constexpr (lazy)
+                return producer_.own;
+            else
+                return writeIdx_.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] size_t readCursor() const noexcept
+        {
+            if constexpr (lazy)
+                return consumer_.own;
+            else
+                return readIdx_.load(std::memory_order_relaxed);
+        }
+
+        using cursor_type = std::conditional_t<lazy, detail::LazyCursor, detail::NoLazyCursor>;
+
         /* ------------------------------------------------------------------
          * Storage
          * ----------------------------------------------------------------*/
-        size_t capacity_;            ///< total usable slots (power of 2)
-        std::unique_ptr<T[]> items_; ///< heap allocated buffer
+        size_t capacity_;                              ///< total usable slots (power of 2)
+        typename Storage::template buffer<T> storage_; ///< owns the slots
+        T* items_;                                     ///< storage_.data()
 
         alignas(detail::cacheline_size) std::atomic<size_t> readIdx_{0};  ///< consumer cursor
+        [[no_unique_address]] typename Stats::consumer_side consumerStats_;
+        [[no_unique_address]] cursor_type consumer_; ///< lazy: private read cursor
+
         alignas(detail::cacheline_size) std::atomic<size_t> writeIdx_{0}; ///< producer cursor
+        [[no_unique_address]] typename Stats::template producer_side<> producerStats_;
+        [[no_unique_address]] cursor_type producer_; ///< lazy: private write cursor
     };
 }
\ No newline at end of file
@@ -0,0 +1,194 @@
+/**
+ * @file wait_strategy.hpp
+ * @brief Pluggable **idle policies** for threads that poll lockedin queues.
+ *
+ * Every queue in the library is non-blocking: `pop()` returns false when there is nothing to
+ * do. What a consumer does next is a latency/CPU trade-off, so the components built on top of
+ * the queues (executor, sequencer, ...) take the choice as a template parameter.
+ *
+ * A wait strategy instance belongs to **one** waiting thread and offers:
+ *
+ * * `idle(ready)`  – called after a poll found no work; `ready()` re-checks for work and lets
+ *                    blocking strategies close the lost-wakeup window before sleeping.
+ * * `reset()`      – called after useful work so back-off starts from scratch.
+ * * `notify()`     – called by a publisher after making work visible to that thread.
+ *
+ * | Strategy         | Idle cost          | Wake latency    | `notify()` cost               |
+ * | :---             | :---               | :---            | :---                          |
+ * | `BusySpinWait`   | one core, 100%     | lowest          | none                          |
+ * | `YieldingWait`   | one core, yielding | scheduler slice | none                          |
+ * | `BackoffWait`    | spin → yield → nap | bounded by nap  | none                          |
+ * | `BlockingWait`   | none (futex)       | syscall         | fence + load, syscall if asleep |
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace lockedin
+{
+    namespace detail
+    {
+        /**
+         * @brief Hint to the CPU that we are in a spin loop (PAUSE / YIELD).
+         */
+        inline void cpu_relax() noexcept
+        {
+#if defined(__i386__) || defined(__x86_64__)
+            _mm_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield" ::: "memory");
+#endif
+        }
+    } // namespace detail
+
+    /**
+     * @brief Never gives up the core; lowest latency, burns a full CPU while idle.
+     */
+    struct BusySpinWait
+    {
+        template <typename Ready> void idle(Ready&&) noexcept
+        {
+            detail::cpu_relax();
+        }
+
+        void reset() noexcept
+        {
+        }
+
+        void notify() noexcept
+        {
+        }
+    };
+
+    /**
+     * @brief Yields to the OS scheduler on every empty poll.
+     */
+    struct YieldingWait
+    {
+        template <typename Ready> void idle(Ready&&) noexcept
+        {
+            std::this_thread::yield();
+        }
+
+        void reset() noexcept
+        {
+        }
+
+        void notify() noexcept
+        {
+        }
+    };
+
+    /**
+     * @brief Spins, then yields, then sleeps for `NapMicros`; reset on every successful poll.
+     */
+    template <std::uint32_t SpinRounds = 128, std::uint32_t YieldRounds = 64,
+              std::uint32_t NapMicros = 50>
+    class BackoffWait
+    {
+    public:
+        template <typename Ready> void idle(Ready&&) noexcept
+        {
+            if (rounds_ < SpinRounds)
+                detail::cpu_relax();
+            else if (rounds_ < SpinRounds + YieldRounds)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(NapMicros));
+            if (rounds_ < SpinRounds + YieldRounds)
+                ++rounds_;
+        }
+
+        void reset() noexcept
+        {
+            rounds_ = 0;
+        }
+
+        void notify() noexcept
+        {
+        }
+
+    private:
+        std::uint32_t rounds_{0};
+    };
+
+    /**
+     * @brief Spins briefly, then parks on a futex (`std::atomic::wait`) until notified.
+     *
+     * The waiter announces itself in `sleepers_` (seq_cst RMW) before re-checking `ready()`;
+     * the publisher issues a seq_cst fence after publishing and only pays for the wake-up
+     * syscall when somebody is actually asleep.
+     */
+    template <std::uint32_t SpinRounds = 256> class BlockingWait
+    {
+    public:
+        template <typename Ready> void idle(Ready&& ready) noexcept
+        {
+            if (rounds_ < SpinRounds)
+            {
+                ++rounds_;
+                detail::cpu_relax();
+                return;
+            }
+
+            sleepers_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto epoch = epoch_.load(std::memory_order_seq_cst);
+            if (!ready())
+                epoch_.wait(epoch, std::memory_order_seq_cst);
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void reset() noexcept
+        {
+            rounds_ = 0;
+        }
+
+        void notify() noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleepers_.load(std::memory_order_relaxed) == 0)
+                return;
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            epoch_.notify_all();
+        }
+
+    private:
+        alignas(detail::cacheline_size) std::atomic<std::uint32_t> epoch_{0};
+        std::atomic<std::uint32_t> sleepers_{0};
+        alignas(detail::cacheline_size) std::uint32_t rounds_{0}; ///< owned by the waiter
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Contract shared by the wait strategies above.
+         */
+        template <typename Wait>
+        concept WaitStrategy = requires(Wait& wait, bool (*ready)()) {
+            wait.idle(ready);
+            wait.reset();
+            wait.notify();
+        };
+
+        template <typename Wait> inline constexpr bool parks_v = false;
+        template <std::uint32_t SpinRounds>
+        inline constexpr bool parks_v<BlockingWait<SpinRounds>> = true;
+
+        /**
+         * @brief A strategy that comes back on its own, for waiters nobody calls `notify()` for.
+         */
+        template <typename Wait>
+        concept PollingWaitStrategy = WaitStrategy<Wait> && !parks_v<Wait>;
+    } // namespace detail
+}
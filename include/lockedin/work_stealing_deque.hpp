@@ -0,0 +1,184 @@
+/**
+ * @file work_stealing_deque.hpp
+ * @brief Header-only **bounded Chase-Lev work-stealing deque**.
+ *
+ * One owner thread pushes and pops at the *bottom* (LIFO, cache-hot), any number of thieves
+ * steal from the *top* (FIFO, oldest and usually largest piece of work). The algorithm follows
+ * Lê, Pop, Cohen & Zappa Nardelli, *Correct and Efficient Work-Stealing for Weak Memory
+ * Models* (PPoPP 2013), with a fixed power-of-2 ring instead of a growable array so that, like
+ * every other lockedin queue, there is no allocation after construction.
+ *
+ * ## Complexity
+ * * `push()`  – *O(1)* / wait-free (returns false immediately if full). Owner only.
+ * * `pop()`   – *O(1)* / wait-free; one CAS only when racing thieves for the last element.
+ * * `steal()` – *O(1)* / lock-free; returns false when empty or when it lost a race.
+ *
+ * ## Memory ordering
+ * * Owner publishes a slot with a release store of `bottom_` (the paper's release fence +
+ *   relaxed store, expressed so that thread sanitizers can follow it).
+ * * `pop()` reserves the bottom element, then a seq_cst fence orders that reservation before
+ *   reading `top_`; thieves mirror it with a seq_cst fence between `top_` and `bottom_`.
+ * * The last element is arbitrated by a seq_cst CAS on `top_`.
+ *
+ * Slots are `std::atomic<T>` because a thief may read a slot that the owner is refilling after
+ * the thief has already lost its race; `T` must therefore be lock-free atomic (pointers,
+ * indices, small handles).
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace lockedin
+{
+    /**
+     * @tparam T Element type; trivially copyable and lock-free as `std::atomic<T>`.
+     *
+     * @class ChaseLevDeque
+     * @brief Owner push/pop at the bottom, concurrent steal at the top.
+     */
+    template <typename T> class ChaseLevDeque : public AbstractQ<T, ChaseLevDeque<T>>
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+        static_assert(std::atomic<T>::is_always_lock_free, "std::atomic<T> must be lock-free.");
+
+    public:
+        /**
+         * @brief Construct with a specific capacity.
+         * @param capacity Must be a **power of 2** and greater than 1.
+         * @throws std::logic_error if capacity is invalid.
+         */
+        explicit ChaseLevDeque(std::size_t capacity)
+            : AbstractQ<T, ChaseLevDeque<T>>(capacity), capacity_{capacity}, mask_{capacity - 1},
+              items_{std::make_unique<std::atomic<T>[]>(capacity)}
+        {
+            if (capacity_ < 2 || (capacity_ & (capacity_ - 1)) != 0)
+                throw std::logic_error("Capacity must be a power of 2, and greater than 1.");
+        }
+
+        ChaseLevDeque(const ChaseLevDeque&) = delete;
+        ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+        ChaseLevDeque(ChaseLevDeque&&) = delete;
+        ChaseLevDeque& operator=(ChaseLevDeque&&) = delete;
+
+        ~ChaseLevDeque() = default;
+
+        /* ------------------------------------------------------------------
+         * Owner API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Pushes at the bottom. Owner thread only.
+         * @return true if successful, false if the deque is full.
+         */
+        bool push(const T& item)
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed);
+            const auto top = top_.load(std::memory_order_acquire);
+            if (bottom - top >= static_cast<std::int64_t>(capacity_))
+                return false; // Full
+
+            items_[static_cast<std::size_t>(bottom) & mask_].store(item, std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool push(T&& item)
+        {
+            return push(static_cast<const T&>(item));
+        }
+
+        /**
+         * @brief Pops the most recently pushed element. Owner thread only.
+         * @return true if successful, false if empty or a thief took the last element.
+         */
+        bool pop(T& item)
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            bottom_.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = top_.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return false; // Empty
+            }
+
+            item = items_[static_cast<std::size_t>(bottom) & mask_].load(std::memory_order_relaxed);
+            if (top != bottom)
+                return true; // more than one element left, no race possible
+
+            // Last element: race the thieves for it.
+            const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        /* ------------------------------------------------------------------
+         * Thief API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @brief Steals the oldest element. Any thread.
+         * @return true if successful, false if empty or another thread won the race.
+         */
+        bool steal(T& item)
+        {
+            auto top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = bottom_.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return false; // Empty
+
+            item = items_[static_cast<std::size_t>(top) & mask_].load(std::memory_order_relaxed);
+            return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                std::memory_order_relaxed);
+        }
+
+        /* ------------------------------------------------------------------
+         * Status API
+         * ----------------------------------------------------------------*/
+
+        /**
+         * @note Approximate when called concurrently with the owner or thieves.
+         */
+        [[nodiscard]] bool full() const
+        {
+            return size() >= capacity_;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return size() == 0;
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed);
+            const auto top = top_.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+        }
+
+    private:
+        /* ------------------------------------------------------------------
+         * Storage
+         * ----------------------------------------------------------------*/
+        std::size_t capacity_;                    ///< total usable slots (power of 2)
+        std::size_t mask_;                        ///< capacity_ - 1
+        std::unique_ptr<std::atomic<T>[]> items_; ///< heap allocated ring
+
+        alignas(detail::cacheline_size) std::atomic<std::int64_t> top_{0};    ///< thieves' end
+        alignas(detail::cacheline_size) std::atomic<std::int64_t> bottom_{0}; ///< owner's end
+    };
+}
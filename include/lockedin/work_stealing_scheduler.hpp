@@ -0,0 +1,263 @@
+/**
+ * @file work_stealing_scheduler.hpp
+ * @brief Small **fork-join scheduler** on top of `ChaseLevDeque`.
+ *
+ * Each worker owns a `ChaseLevDeque<Job*>`. `parallel_for` splits its range in halves, pushes
+ * the right half on the local deque and recurses into the left half, so that idle workers
+ * steal the largest outstanding pieces from the top while the owner keeps the hot, small ones
+ * at the bottom. A parent waits for a stolen child by *helping*: it keeps stealing and running
+ * other jobs until the child's counter drops to zero.
+ *
+ * Jobs live in the stack frame of the parent that forked them, so fork-join never allocates.
+ * Calls from outside the pool are routed round-robin to a worker's `MPSCQ<Job*>` inbox and the
+ * caller yields until its root job has completed; calls from inside a worker (nested
+ * parallelism) run directly on that worker's deque.
+ *
+ * If a deque is full the remaining range is simply run serially by the owner.
+ */
+
+#pragma once
+
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/mpsc_queue.hpp>
+#include <lockedin/wait_strategy.hpp>
+#include <lockedin/work_stealing_deque.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lockedin
+{
+    /**
+     * @tparam Wait Idle policy for workers with nothing to run or steal.
+     *
+     * @class WorkStealingScheduler
+     * @brief Fixed pool of workers balancing fork-join work by stealing.
+     */
+    template <typename Wait = BackoffWait<>>
+        requires detail::WaitStrategy<Wait>
+    class WorkStealingScheduler
+    {
+    public:
+        /**
+         * @param workers         Number of worker threads (> 0).
+         * @param dequeCapacity   Slots per worker deque; power of 2. Bounds the fork depth that
+         *                        can be exposed to thieves, not the size of the range.
+         * @throws std::logic_error if `workers` is 0 or the capacity is invalid.
+         */
+        explicit WorkStealingScheduler(std::size_t workers, std::size_t dequeCapacity = 1024)
+        {
+            if (workers == 0)
+                throw std::logic_error("WorkStealingScheduler needs at least one worker.");
+
+            workers_.reserve(workers);
+            for (std::size_t i = 0; i < workers; ++i)
+                workers_.push_back(std::make_unique<Worker>(i, dequeCapacity));
+            for (auto& worker : workers_)
+                worker->thread = std::thread([this, w = worker.get()] { run(*w); });
+        }
+
+        WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+        WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+        WorkStealingScheduler(WorkStealingScheduler&&) = delete;
+        WorkStealingScheduler& operator=(WorkStealingScheduler&&) = delete;
+
+        ~WorkStealingScheduler()
+        {
+            stopping_.store(true, std::memory_order_release);
+            for (auto& worker : workers_)
+                worker->wait.notify();
+            for (auto& worker : workers_)
+                if (worker->thread.joinable())
+                    worker->thread.join();
+        }
+
+        /**
+         * @brief Runs `body(lo, hi)` over disjoint sub-ranges covering `[begin, end)`.
+         * @param grain Largest sub-range handed to `body` in one call (> 0).
+         * @note Blocks until every sub-range has run. `body` must not throw.
+         */
+        template <typename Body>
+        void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, Body&& body)
+        {
+            if (begin >= end)
+                return;
+            if (grain == 0)
+                grain = 1;
+
+            using BodyT = std::remove_reference_t<Body>;
+            if (current_owner_ == this)
+            {
+                split<BodyT>(body, begin, end, grain, *current_worker_);
+                return;
+            }
+
+            std::atomic<std::uint32_t> pending{1};
+            Job root{&runJob<BodyT>, std::addressof(body), begin, end, grain, &pending};
+            auto& target = *workers_[next_.fetch_add(1, std::memory_order_relaxed) %
+                                     workers_.size()];
+            while (!target.inbox.push(&root))
+                std::this_thread::yield();
+            target.wait.notify();
+
+            while (pending.load(std::memory_order_acquire) != 0)
+                std::this_thread::yield();
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return workers_.size();
+        }
+
+    private:
+        struct Worker;
+
+        struct Job
+        {
+            void (*execute)(Job&, Worker&);
+            void* body;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t grain;
+            std::atomic<std::uint32_t>* pending; ///< decremented once the job has finished
+        };
+
+        struct Worker
+        {
+            Worker(std::size_t idx, std::size_t dequeCapacity)
+                : deque(dequeCapacity), inbox(64), index{idx}, rng{idx * 0x9E3779B97F4A7C15ULL + 1}
+            {
+            }
+
+            ChaseLevDeque<Job*> deque;
+            MPSCQ<Job*> inbox; ///< root jobs submitted from outside the pool
+            alignas(detail::cacheline_size) Wait wait;
+            std::size_t index;
+            std::uint64_t rng; ///< xorshift state for victim selection
+            std::thread thread;
+        };
+
+        template <typename Body> static void runJob(Job& job, Worker& self)
+        {
+            auto& owner = *current_owner_;
+            owner.template split<Body>(*static_cast<Body*>(job.body), job.begin, job.end,
+                                       job.grain, self);
+            job.pending->fetch_sub(1, std::memory_order_release); // job is dead after this
+        }
+
+        template <typename Body>
+        void split(Body& body, std::size_t begin, std::size_t end, std::size_t grain, Worker& self)
+        {
+            if (end - begin <= grain)
+            {
+                body(begin, end);
+                return;
+            }
+
+            const auto mid = begin + (end - begin) / 2;
+            std::atomic<std::uint32_t> pending{1};
+            Job right{&runJob<Body>, std::addressof(body), mid, end, grain, &pending};
+            if (!self.deque.push(&right))
+            {
+                // Deque full: no more parallelism to expose, but keep the grain contract.
+                for (; end - begin > grain; begin += grain)
+                    body(begin, begin + grain);
+                body(begin, end);
+                return;
+            }
+            wakeNeighbour(self);
+
+            split(body, begin, mid, grain, self);
+
+            // LIFO discipline: if nobody stole it, `right` is on top of our deque.
+            Job* top = nullptr;
+            if (self.deque.pop(top))
+            {
+                split(body, mid, end, grain, self);
+                return;
+            }
+            helpUntil(pending, self);
+        }
+
+        void helpUntil(const std::atomic<std::uint32_t>& pending, Worker& self)
+        {
+            while (pending.load(std::memory_order_acquire) != 0)
+            {
+                Job* job = nullptr;
+                if (self.deque.pop(job) || trySteal(self, job))
+                    job->execute(*job, self);
+                else
+                    detail::cpu_relax();
+            }
+        }
+
+        bool trySteal(Worker& self, Job*& job)
+        {
+            const auto n = workers_.size();
+            if (n == 1)
+                return false;
+
+            self.rng ^= self.rng << 13;
+            self.rng ^= self.rng >> 7;
+            self.rng ^= self.rng << 17;
+            const auto start = static_cast<std::size_t>(self.rng % n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                auto& victim = *workers_[(start + i) % n];
+                if (&victim != &self && victim.deque.steal(job))
+                    return true;
+            }
+            return false;
+        }
+
+        void wakeNeighbour(Worker& self)
+        {
+            workers_[(self.index + 1) % workers_.size()]->wait.notify();
+        }
+
+        bool anyWork(const Worker& self) const
+        {
+            if (stopping_.load(std::memory_order_acquire) || !self.inbox.empty())
+                return true;
+            for (const auto& worker : workers_)
+                if (!worker->deque.empty())
+                    return true;
+            return false;
+        }
+
+        void run(Worker& self)
+        {
+            current_owner_ = this;
+            current_worker_ = &self;
+            const auto ready = [&] { return anyWork(self); };
+
+            while (!stopping_.load(std::memory_order_acquire))
+            {
+                Job* job = nullptr;
+                if (self.deque.pop(job) || self.inbox.pop(job) || trySteal(self, job))
+                {
+                    job->execute(*job, self);
+                    self.wait.reset();
+                }
+                else
+                {
+                    self.wait.idle(ready);
+                }
+            }
+        }
+
+        static inline thread_local WorkStealingScheduler* current_owner_ = nullptr;
+        static inline thread_local Worker* current_worker_ = nullptr;
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        alignas(detail::cacheline_size) std::atomic<std::size_t> next_{0};
+        alignas(detail::cacheline_size) std::atomic<bool> stopping_{false};
+    };
+}
@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/spsc_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+struct Tick
+{
+    std::uint64_t sequence;
+    std::uint64_t instrument;
+    double bid;
+    double ask;
+    std::int64_t bidSize;
+    std::int64_t askSize;
+    std::uint64_t exchangeTime;
+    std::uint64_t receiveTime;
+};
+static_assert(sizeof(Tick) == 64);
+
+static constexpr size_t ring_capacity = 8192;
+static constexpr size_t stream_messages = 1 << 18;
+
+enum class transfer
+{
+    element_wise,
+    bulk,
+    bulk_streaming
+};
+
+template <transfer How>
+static size_t push_burst(lockedin::SPSCQ<Tick>& q, const Tick* ticks, size_t n)
+{
+    if constexpr (How == transfer::element_wise)
+    {
+        size_t pushed = 0;
+        while (pushed < n && q.push(ticks[pushed]))
+            ++pushed;
+        return pushed;
+    }
+    else if constexpr (How == transfer::bulk)
+        return q.pushBulk(ticks, n);
+    else
+        return q.pushBulk<lockedin::BulkStore::Streaming>(ticks, n);
+}
+
+template <transfer How> static size_t pop_burst(lockedin::SPSCQ<Tick>& q, Tick* out, size_t n)
+{
+    if constexpr (How == transfer::element_wise)
+    {
+        size_t popped = 0;
+        while (popped < n && q.pop(out[popped]))
+            ++popped;
+        return popped;
+    }
+    else
+        return q.popBulk(out, n);
+}
+
+// Push a burst of `range(0)` ticks and pop it back on one thread: pure copy cost.
+template <transfer How> static void burst_round_trip(benchmark::State& st)
+{
+    const auto burst = static_cast<size_t>(st.range(0));
+    lockedin::SPSCQ<Tick> q(ring_capacity);
+    std::vector<Tick> in(burst, Tick{1, 2, 100.0, 100.5, 10, 20, 0, 0});
+    std::vector<Tick> out(burst);
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        push_burst<How>(q, in.data(), burst);
+        pop_burst<How>(q, out.data(), burst);
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * burst));
+    st.SetBytesProcessed(static_cast<int64_t>(st.iterations() * burst * sizeof(Tick)));
+}
+
+// A producer thread streams ticks in bursts of `range(0)`; the benchmark thread drains them
+// in bursts of the same size.
+template <transfer How> static void burst_stream(benchmark::State& st)
+{
+    const auto burst = static_cast<size_t>(st.range(0));
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        lockedin::SPSCQ<Tick> q(ring_capacity);
+        std::atomic<bool> go = false;
+        std::thread producer(
+            [&]
+            {
+                std::vector<Tick> in(burst, Tick{1, 2, 100.0, 100.5, 10, 20, 0, 0});
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (size_t sent = 0; sent < stream_messages;)
+                {
+                    const auto n =
+                        push_burst<How>(q, in.data(), std::min(burst, stream_messages - sent));
+                    if (n == 0)
+                        std::this_thread::yield();
+                    sent += n;
+                }
+            });
+        std::vector<Tick> out(burst);
+        st.ResumeTiming();
+
+        go.store(true, std::memory_order_release);
+        for (size_t received = 0; received < stream_messages;)
+        {
+            const auto n = pop_burst<How>(q, out.data(), burst);
+            if (n == 0)
+                std::this_thread::yield();
+            received += n;
+        }
+        benchmark::DoNotOptimize(out.data());
+
+        st.PauseTiming();
+        producer.join();
+        st.ResumeTiming();
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * stream_messages));
+    st.SetBytesProcessed(static_cast<int64_t>(st.iterations() * stream_messages * sizeof(Tick)));
+}
+
+static void bursts(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(4)->Range(64, 4096);
+}
+
+BENCHMARK(burst_round_trip<transfer::element_wise>)->Apply(bursts);
+BENCHMARK(burst_round_trip<transfer::bulk>)->Apply(bursts);
+BENCHMARK(burst_round_trip<transfer::bulk_streaming>)->Apply(bursts);
+
+BENCHMARK(burst_stream<transfer::element_wise>)->Apply(bursts)->UseRealTime();
+BENCHMARK(burst_stream<transfer::bulk>)->Apply(bursts)->UseRealTime();
+BENCHMARK(burst_stream<transfer::bulk_streaming>)->Apply(bursts)->UseRealTime();
+
+BENCHMARK_MAIN();
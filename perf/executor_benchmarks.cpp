@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/executor.hpp>
+#include <lockedin/wait_strategy.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr size_t inbox_size = 1024 << 2;
+
+// Reference point: the pool everybody writes first.
+class mutex_cv_pool
+{
+public:
+    explicit mutex_cv_pool(size_t n_workers)
+    {
+        for (size_t i = 0; i < n_workers; ++i)
+            workers.emplace_back([this] { run(); });
+    }
+
+    ~mutex_cv_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    template <typename F> void submit(F&& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back(std::forward<F>(task));
+        }
+        cv.notify_one();
+    }
+
+private:
+    void run()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
+
+template <typename Wait> struct lockedin_pool : lockedin::Executor<Wait>
+{
+    explicit lockedin_pool(size_t n_workers) : lockedin::Executor<Wait>(n_workers, inbox_size)
+    {
+    }
+};
+
+// Time from submit() until the worker has run the task and the submitter observed it.
+template <typename Pool> static void dispatch_latency(benchmark::State& st)
+{
+    Pool pool(1);
+    std::atomic<size_t> completed = 0;
+
+    size_t iteration = 0;
+    for ([[maybe_unused]] auto _ : st)
+    {
+        ++iteration;
+        pool.submit([&completed] { completed.fetch_add(1, std::memory_order_release); });
+        while (completed.load(std::memory_order_acquire) != iteration)
+        {
+        }
+    }
+
+    st.SetItemsProcessed(st.iterations());
+}
+
+// Sustained submission of tiny tasks to `range(0)` workers.
+template <typename Pool> static void dispatch_throughput(benchmark::State& st)
+{
+    const size_t n_workers = static_cast<size_t>(st.range(0));
+    constexpr size_t batch = 1024;
+    Pool pool(n_workers);
+    std::atomic<size_t> completed = 0;
+
+    size_t submitted = 0;
+    for ([[maybe_unused]] auto _ : st)
+    {
+        for (size_t i = 0; i < batch; ++i)
+            pool.submit([&completed] { completed.fetch_add(1, std::memory_order_relaxed); });
+        submitted += batch;
+        while (completed.load(std::memory_order_acquire) != submitted)
+            std::this_thread::yield();
+    }
+
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * batch));
+}
+
+BENCHMARK(dispatch_latency<lockedin_pool<lockedin::BusySpinWait>>)->UseRealTime();
+BENCHMARK(dispatch_latency<lockedin_pool<lockedin::YieldingWait>>)->UseRealTime();
+BENCHMARK(dispatch_latency<lockedin_pool<lockedin::BackoffWait<>>>)->UseRealTime();
+BENCHMARK(dispatch_latency<lockedin_pool<lockedin::BlockingWait<>>>)->UseRealTime();
+BENCHMARK(dispatch_latency<mutex_cv_pool>)->UseRealTime();
+
+BENCHMARK(dispatch_throughput<lockedin_pool<lockedin::BusySpinWait>>)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK(dispatch_throughput<lockedin_pool<lockedin::YieldingWait>>)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK(dispatch_throughput<lockedin_pool<lockedin::BackoffWait<>>>)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK(dispatch_throughput<lockedin_pool<lockedin::BlockingWait<>>>)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK(dispatch_throughput<mutex_cv_pool>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+BENCHMARK_MAIN();
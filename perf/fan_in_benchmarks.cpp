@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/fan_in_queue.hpp>
+#include <lockedin/mpsc_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+static constexpr size_t messages_per_producer = 1 << 14;
+static constexpr size_t total_capacity = 1024 << 4;
+
+template <typename Q> struct producer_handle
+{
+    Q& queue;
+    explicit producer_handle(Q& q, size_t) : queue(q)
+    {
+    }
+
+    bool push(size_t value)
+    {
+        return queue.push(value);
+    }
+};
+
+template <typename Merge> struct producer_handle<lockedin::FanInQ<size_t, Merge>>
+{
+    lockedin::FanInProducer<size_t, Merge> producer;
+    explicit producer_handle(lockedin::FanInQ<size_t, Merge>& q, size_t index)
+        : producer(q.getProducer(index))
+    {
+    }
+
+    bool push(size_t value)
+    {
+        return producer.push(value);
+    }
+};
+
+// Aggregate throughput of `range(0)` producers into one consumer (the benchmark thread).
+template <typename Q, typename Factory>
+static void fan_in_throughput(benchmark::State& st, Factory make)
+{
+    const size_t n_producers = static_cast<size_t>(st.range(0));
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        auto queue = make(n_producers);
+        std::atomic<bool> go = false;
+        std::vector<std::thread> producers;
+        producers.reserve(n_producers);
+        for (size_t p = 0; p < n_producers; ++p)
+            producers.emplace_back(
+                [&, p]
+                {
+                    producer_handle<Q> handle(*queue, p);
+                    while (!go.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                    for (size_t i = 0; i < messages_per_producer; ++i)
+                        while (!handle.push(i))
+                            std::this_thread::yield();
+                });
+        st.ResumeTiming();
+
+        go.store(true, std::memory_order_release);
+        size_t received = 0;
+        size_t out = 0;
+        while (received < n_producers * messages_per_producer)
+            if (queue->pop(out))
+                ++received;
+        benchmark::DoNotOptimize(out);
+
+        st.PauseTiming();
+        for (auto& producer : producers)
+            producer.join();
+        st.ResumeTiming();
+    }
+
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * n_producers *
+                                              messages_per_producer));
+}
+
+static void fan_in_mpsc(benchmark::State& st)
+{
+    fan_in_throughput<lockedin::MPSCQ<size_t>>(
+        st, [](size_t) { return std::make_unique<lockedin::MPSCQ<size_t>>(total_capacity); });
+}
+
+static void fan_in_spsc_round_robin(benchmark::State& st)
+{
+    using Q = lockedin::FanInQ<size_t, lockedin::RoundRobinMerge>;
+    fan_in_throughput<Q>(st,
+                         [](size_t n)
+                         {
+                             const size_t per_inbox = std::max<size_t>(64, total_capacity / n);
+                             return std::make_unique<Q>(n, std::bit_ceil(per_inbox));
+                         });
+}
+
+static void fan_in_spsc_weighted(benchmark::State& st)
+{
+    using Q = lockedin::FanInQ<size_t, lockedin::WeightedMerge>;
+    fan_in_throughput<Q>(st,
+                         [](size_t n)
+                         {
+                             const size_t per_inbox = std::max<size_t>(64, total_capacity / n);
+                             return std::make_unique<Q>(
+                                 n, std::bit_ceil(per_inbox),
+                                 lockedin::WeightedMerge(std::vector<std::uint32_t>(n, 16)));
+                         });
+}
+
+struct identity_key
+{
+    size_t operator()(size_t value) const noexcept
+    {
+        return value;
+    }
+};
+
+static void fan_in_spsc_timestamp(benchmark::State& st)
+{
+    using Q = lockedin::FanInQ<size_t, lockedin::TimestampMerge<identity_key>>;
+    fan_in_throughput<Q>(st,
+                         [](size_t n)
+                         {
+                             const size_t per_inbox = std::max<size_t>(64, total_capacity / n);
+                             return std::make_unique<Q>(n, std::bit_ceil(per_inbox));
+                         });
+}
+
+BENCHMARK(fan_in_mpsc)->RangeMultiplier(2)->Range(2, 64)->UseRealTime();
+BENCHMARK(fan_in_spsc_round_robin)->RangeMultiplier(2)->Range(2, 64)->UseRealTime();
+BENCHMARK(fan_in_spsc_weighted)->RangeMultiplier(2)->Range(2, 64)->UseRealTime();
+BENCHMARK(fan_in_spsc_timestamp)->RangeMultiplier(2)->Range(2, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -7,20 +7,35 @@
 #include <lockedin/spmc_queue.hpp>
 #include <lockedin/spsc_queue.hpp>
 
+#include "perf_helpers.hpp"
+
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <string>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <iostream>
 
 static constexpr size_t queue_size = 1024 << 4;
+static constexpr size_t messages_per_producer = 1 << 13;
+static constexpr size_t latency_sample_every = 16;
 
 enum class queue_type
 {
     spsc,
     mpsc,
+    mpsc_stats,
     spmc,
     boost_spsc,
     boost_mpsc,
@@ -43,6 +58,13 @@ template <typename T> struct queue_wrapper<T, queue_type::spsc> : public lockedi
         {
         }
     }
+
+    void push(T&& value)
+    {
+        while (!lockedin::SPSCQ<T>::push(std::move(value)))
+        {
+        }
+    }
 };
 
 template <typename T> struct queue_wrapper<T, queue_type::boost_spsc>
@@ -72,6 +94,16 @@ template <typename T> struct queue_wrapper<T, queue_type::mpsc> : public lockedi
     }
 };
 
+// Same queue with telemetry on, to read the CAS retry counter.
+template <typename T>
+struct queue_wrapper<T, queue_type::mpsc_stats> : public lockedin::MPSCQ<T, lockedin::QueueStats<>>
+{
+    explicit queue_wrapper(size_t n_elements)
+        : lockedin::MPSCQ<T, lockedin::QueueStats<>>(n_elements)
+    {
+    }
+};
+
 template <typename T> struct queue_wrapper<T, queue_type::spmc>
 {
     explicit queue_wrapper(size_t n_elements)
@@ -88,7 +120,7 @@ template <typename T> struct queue_wrapper<T, queue_type::spmc>
 
     bool pop(T& value)
     {
-        return default_consumer.pop(value);
+        return default_consumer->pop(value);
     }
 
     lockedin::SPMCConsumer<T> make_consumer()
@@ -96,10 +128,18 @@ template <typename T> struct queue_wrapper<T, queue_type::spmc>
         return queue.getConsumer();
     }
 
+    // Swaps the lossy default consumer for a reliable one, so a streaming producer waits for
+    // it instead of lapping it.
+    void make_default_reliable()
+    {
+        default_consumer.reset();
+        default_consumer.emplace(queue.getReliableConsumer());
+    }
+
 private:
     lockedin::SPMCQ<T> queue;
     lockedin::SPMCProducer<T> producer;
-    lockedin::SPMCConsumer<T> default_consumer;
+    std::optional<lockedin::SPMCConsumer<T>> default_consumer;
 };
 
 template <typename T> struct queue_wrapper<T, queue_type::boost_mpsc>
@@ -144,7 +184,7 @@ template <typename T> struct queue_wrapper<T, queue_type::mutex>
         std::lock_guard<std::mutex> lock(mutex);
         if (queue.size() == 0)
             return false;
-        value = queue.front();
+        value = std::move(queue.front());
         queue.pop();
         return true;
     }
@@ -413,6 +453,255 @@ static void callsite_push_latency_spmc_multi_consumer(benchmark::State& st)
     st.SetItemsProcessed(st.iterations());
 }
 
+// Pushes until accepted; lockedin queues report full, the other wrappers spin internally.
+template <typename Q> static void push_until_accepted(Q& q, size_t value)
+{
+    if constexpr (std::is_same_v<decltype(q.push(value)), bool>)
+    {
+        while (!q.push(value))
+            std::this_thread::yield();
+    }
+    else
+        q.push(value);
+}
+
+static void producer_counts(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(2)->Range(2, 64)->UseRealTime();
+}
+
+// `range(0)` producers push `messages_per_producer` each into one consumer (the benchmark
+// thread). Reports aggregate throughput, the distribution of sampled call-site push latencies
+// across all producers, and for the instrumented MPSCQ the head CAS failure rate.
+template <queue_type type> static void multi_producer_contention(benchmark::State& st)
+{
+    using clock = std::chrono::steady_clock;
+    const size_t n_producers = static_cast<size_t>(st.range(0));
+    std::vector<double> latencies;
+    double cas_retries = 0;
+    double pushes = 0;
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        auto q = std::make_unique<queue_wrapper<size_t, type>>(queue_size);
+        std::atomic<bool> go = false;
+        std::vector<std::vector<double>> samples(n_producers);
+        std::vector<std::thread> producers;
+        producers.reserve(n_producers);
+        for (size_t p = 0; p < n_producers; ++p)
+            producers.emplace_back(
+                [&, p]
+                {
+                    auto& local = samples[p];
+                    local.reserve(messages_per_producer / latency_sample_every);
+                    while (!go.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                    for (size_t i = 0; i < messages_per_producer; ++i)
+                    {
+                        if (i % latency_sample_every != 0)
+                        {
+                            push_until_accepted(*q, i);
+                            continue;
+                        }
+                        const auto start = clock::now();
+                        push_until_accepted(*q, i);
+                        local.push_back(
+                            std::chrono::duration<double, std::nano>(clock::now() - start)
+                                .count());
+                    }
+                });
+        st.ResumeTiming();
+
+        go.store(true, std::memory_order_release);
+        size_t out = 0;
+        for (size_t received = 0; received < n_producers * messages_per_producer;)
+            if (q->pop(out))
+                ++received;
+        benchmark::DoNotOptimize(out);
+
+        st.PauseTiming();
+        for (auto& producer : producers)
+            producer.join();
+        for (auto& local : samples)
+            latencies.insert(latencies.end(), local.begin(), local.end());
+        if constexpr (type == queue_type::mpsc_stats)
+        {
+            const auto stats = q->stats();
+            cas_retries += static_cast<double>(stats.casRetries);
+            pushes += static_cast<double>(stats.pushes);
+        }
+        st.ResumeTiming();
+    }
+
+    st.SetItemsProcessed(
+        static_cast<int64_t>(st.iterations() * n_producers * messages_per_producer));
+    st.counters["push_p50_ns"] = percentile(latencies, 0.50);
+    st.counters["push_p99_ns"] = percentile(latencies, 0.99);
+    st.counters["push_p999_ns"] = percentile(latencies, 0.999);
+    if constexpr (type == queue_type::mpsc_stats)
+        st.counters["cas_fail_per_push"] = pushes == 0 ? 0.0 : cas_retries / pushes;
+}
+
+/* ---- Payload matrix ---- */
+
+static constexpr size_t payload_messages = 1 << 14;
+
+// Trivially copyable message of `Bytes` bytes; the first 8 carry the sequence number.
+template <size_t Bytes> struct Payload
+{
+    static_assert(Bytes >= sizeof(std::uint64_t));
+    std::uint64_t id;
+    std::array<std::byte, Bytes - sizeof(std::uint64_t)> body;
+};
+
+template <size_t Bytes> struct trivial_payload
+{
+    using type = Payload<Bytes>;
+    static constexpr size_t bytes = Bytes;
+
+    static type make(std::uint64_t i)
+    {
+        return type{i, {}};
+    }
+
+    static std::uint64_t id(const type& p)
+    {
+        return p.id;
+    }
+};
+
+// Copyable with heap memory beyond the small-string buffer.
+template <size_t Bytes> struct string_payload
+{
+    using type = std::string;
+    static constexpr size_t bytes = Bytes;
+
+    static type make(std::uint64_t i)
+    {
+        std::string s(Bytes, 'x');
+        std::memcpy(s.data(), &i, sizeof(i));
+        return s;
+    }
+
+    static std::uint64_t id(const type& s)
+    {
+        std::uint64_t i = 0;
+        std::memcpy(&i, s.data(), sizeof(i));
+        return i;
+    }
+};
+
+// Move-only, one heap allocation per message.
+template <size_t Bytes> struct unique_payload
+{
+    using type = std::unique_ptr<Payload<Bytes>>;
+    static constexpr size_t bytes = Bytes;
+
+    static type make(std::uint64_t i)
+    {
+        return std::make_unique<Payload<Bytes>>(Payload<Bytes>{i, {}});
+    }
+
+    static std::uint64_t id(const type& p)
+    {
+        return p->id;
+    }
+};
+
+template <typename Q, typename T> static void push_payload(Q& q, T&& value)
+{
+    if constexpr (std::is_same_v<decltype(q.push(std::forward<T>(value))), bool>)
+    {
+        while (!q.push(std::forward<T>(value)))
+        {
+        }
+    }
+    else
+        q.push(std::forward<T>(value));
+}
+
+// Push + pop on one thread: construction and copy/move cost with no cross-core traffic.
+template <queue_type type, typename P>
+static void payload_roundtrip_single_thread(benchmark::State& st)
+{
+    queue_wrapper<typename P::type, type> q(queue_size);
+    typename P::type out{};
+    std::uint64_t iteration = 0;
+    for ([[maybe_unused]] auto _ : st)
+    {
+        const auto sent = iteration++;
+        push_payload(q, P::make(sent));
+        q.pop(out);
+        if (P::id(out) != sent)
+            throw std::runtime_error("oops");
+    }
+    st.SetItemsProcessed(st.iterations());
+    st.SetBytesProcessed(static_cast<int64_t>(st.iterations() * P::bytes));
+}
+
+// One producer thread streams `payload_messages` to the benchmark thread.
+template <queue_type type, typename P> static void payload_throughput(benchmark::State& st)
+{
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        auto q = std::make_unique<queue_wrapper<typename P::type, type>>(queue_size);
+        if constexpr (type == queue_type::spmc)
+            q->make_default_reliable();
+        std::atomic<bool> go = false;
+        std::thread producer(
+            [&]
+            {
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (std::uint64_t i = 0; i < payload_messages; ++i)
+                    push_payload(*q, P::make(i));
+            });
+        st.ResumeTiming();
+
+        go.store(true, std::memory_order_release);
+        typename P::type out{};
+        for (std::uint64_t received = 0; received < payload_messages;)
+            if (q->pop(out))
+            {
+                if (P::id(out) != received)
+                    throw std::runtime_error("oops");
+                ++received;
+            }
+
+        st.PauseTiming();
+        producer.join();
+        st.ResumeTiming();
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * payload_messages));
+    st.SetBytesProcessed(static_cast<int64_t>(st.iterations() * payload_messages * P::bytes));
+}
+
+// Every queue that can hold the payload category, at 8/64/256/1024 bytes.
+#define PAYLOAD_SIZES(bench, type, payload)                                                       \
+    BENCHMARK_TEMPLATE(bench, type, payload<8>);                                                 \
+    BENCHMARK_TEMPLATE(bench, type, payload<64>);                                                \
+    BENCHMARK_TEMPLATE(bench, type, payload<256>);                                               \
+    BENCHMARK_TEMPLATE(bench, type, payload<1024>)
+
+// boost::lockfree::queue needs trivial types, spsc_queue copies, and SPMCQ readers may copy a
+// slot mid-overwrite, so they sit out the payload categories they cannot hold.
+#define PAYLOAD_MATRIX(bench)                                                                     \
+    PAYLOAD_SIZES(bench, queue_type::spsc, trivial_payload);                                      \
+    PAYLOAD_SIZES(bench, queue_type::mpsc, trivial_payload);                                      \
+    PAYLOAD_SIZES(bench, queue_type::spmc, trivial_payload);                                      \
+    PAYLOAD_SIZES(bench, queue_type::boost_spsc, trivial_payload);                                \
+    PAYLOAD_SIZES(bench, queue_type::boost_mpsc, trivial_payload);                                \
+    PAYLOAD_SIZES(bench, queue_type::mutex, trivial_payload);                                     \
+    PAYLOAD_SIZES(bench, queue_type::spsc, string_payload);                                       \
+    PAYLOAD_SIZES(bench, queue_type::mpsc, string_payload);                                       \
+    PAYLOAD_SIZES(bench, queue_type::boost_spsc, string_payload);                                 \
+    PAYLOAD_SIZES(bench, queue_type::mutex, string_payload);                                      \
+    PAYLOAD_SIZES(bench, queue_type::spsc, unique_payload);                                       \
+    PAYLOAD_SIZES(bench, queue_type::mpsc, unique_payload);                                       \
+    PAYLOAD_SIZES(bench, queue_type::mutex, unique_payload)
+
 BENCHMARK(callsite_push_latency_single_producer<queue_type::spsc>)->Args({});
 BENCHMARK(callsite_push_latency_single_producer<queue_type::mpsc>)->Args({});
 BENCHMARK(callsite_push_latency_spmc_multi_consumer)->Arg(1)->Arg(2)->Arg(4);
@@ -434,4 +723,12 @@ BENCHMARK(roundtrip_single_thread<queue_type::boost_spsc>)->Args({});
 BENCHMARK(roundtrip_single_thread<queue_type::boost_mpsc>)->Args({});
 BENCHMARK(roundtrip_single_thread<queue_type::mutex>)->Args({});
 
+BENCHMARK(multi_producer_contention<queue_type::mpsc>)->Apply(producer_counts);
+BENCHMARK(multi_producer_contention<queue_type::mpsc_stats>)->Apply(producer_counts);
+BENCHMARK(multi_producer_contention<queue_type::boost_mpsc>)->Apply(producer_counts);
+BENCHMARK(multi_producer_contention<queue_type::mutex>)->Apply(producer_counts);
+
+PAYLOAD_MATRIX(payload_roundtrip_single_thread);
+PAYLOAD_MATRIX(payload_throughput);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/journal_queue.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+struct Order
+{
+    std::uint64_t id;
+    std::uint64_t instrument;
+    double price;
+    std::int64_t quantity;
+};
+
+static constexpr size_t records_per_segment = 1 << 16;
+
+static fs::path scratch(const char* name)
+{
+    auto dir = fs::temp_directory_path() /
+               ("lockedin-journal-bench-" + std::to_string(::getpid()) + "-" + name);
+    fs::remove_all(dir);
+    return dir;
+}
+
+// Appending straight into the mapped journal, per sync policy.
+template <typename Sync> static void journal_append(benchmark::State& st)
+{
+    const auto dir = scratch("append");
+    {
+        lockedin::JournalQ<Order, Sync> journal(dir, records_per_segment);
+        Order order{0, 7, 101.25, 100};
+        for ([[maybe_unused]] auto _ : st)
+        {
+            ++order.id;
+            journal.push(order);
+        }
+        st.SetItemsProcessed(st.iterations());
+        st.SetBytesProcessed(static_cast<int64_t>(st.iterations() * sizeof(Order)));
+    }
+    fs::remove_all(dir);
+}
+
+// Reference point: the hop into an SPSCQ that used to feed a separate journaling thread.
+static void spsc_handoff(benchmark::State& st)
+{
+    lockedin::SPSCQ<Order> queue(records_per_segment);
+    Order order{0, 7, 101.25, 100};
+    Order sink{};
+    for ([[maybe_unused]] auto _ : st)
+    {
+        ++order.id;
+        queue.push(order);
+        queue.pop(sink);
+        benchmark::DoNotOptimize(sink);
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+BENCHMARK(journal_append<lockedin::NoSync>);
+BENCHMARK(journal_append<lockedin::SyncOnRoll>);
+BENCHMARK(journal_append<lockedin::SyncEvery<4096>>);
+BENCHMARK(journal_append<lockedin::SyncEvery<64>>);
+BENCHMARK(spsc_handoff);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,187 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/keyed_dispatcher.hpp>
+#include <lockedin/mpsc_queue.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Parallelising per-instrument processing: one feed thread, `range(0)` workers, and per-
+// instrument state that every message updates. The keyed dispatcher gives each instrument a
+// single owner, so the state needs no lock and updates arrive in feed order. The baseline feeds
+// a shared pool from one MPSCQ; it keeps the state consistent with a mutex per instrument but
+// gives no ordering across workers. `range(1)` skews half of the traffic onto four instruments.
+
+static constexpr std::uint64_t messages = 1 << 16;
+static constexpr std::uint32_t instruments = 256;
+static constexpr std::size_t burst = 32;
+
+using clock_type = std::chrono::steady_clock;
+
+struct Tick
+{
+    std::uint32_t instrument;
+    std::uint64_t price;
+};
+
+struct alignas(lockedin::detail::cacheline_size) Book
+{
+    std::mutex lock; ///< baseline only
+    std::uint64_t last{0};
+    std::uint64_t updates{0};
+};
+
+static void busy_for(std::chrono::nanoseconds delay)
+{
+    const auto until = clock_type::now() + delay;
+    while (clock_type::now() < until)
+    {
+    }
+}
+
+static Tick make_tick(std::uint64_t i, bool skewed)
+{
+    const auto r = i * 2654435761u;
+    const auto hot = skewed && r % 2 == 0;
+    return {static_cast<std::uint32_t>((r >> 8) % (hot ? 4 : instruments)), i};
+}
+
+static void apply(Book& book, const Tick& t)
+{
+    busy_for(std::chrono::nanoseconds(100));
+    book.last = t.price;
+    ++book.updates;
+}
+
+static void keyed_dispatcher(benchmark::State& st)
+{
+    const auto n_workers = static_cast<size_t>(st.range(0));
+    const bool skewed = st.range(1) != 0;
+    const bool rebalance = st.range(2) != 0;
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        lockedin::KeyedDispatcher<Tick, decltype(&Tick::instrument)> stage(
+            n_workers, 1024, &Tick::instrument, 256);
+        std::vector<Book> books(instruments);
+        std::atomic<bool> done = false;
+        std::vector<std::thread> threads;
+        for (size_t w = 0; w < n_workers; ++w)
+        {
+            threads.emplace_back(
+                [&, w]
+                {
+                    auto in = stage.getWorker(w);
+                    std::array<Tick, burst> ticks{};
+                    while (true)
+                    {
+                        const auto n = in.popBulk(ticks.data(), burst);
+                        for (size_t i = 0; i < n; ++i)
+                            apply(books[ticks[i].instrument], ticks[i]);
+                        if (n != 0)
+                            continue;
+                        if (done.load(std::memory_order_acquire) && in.empty())
+                            break;
+                        std::this_thread::yield();
+                    }
+                });
+        }
+        st.ResumeTiming();
+
+        std::array<Tick, burst> ticks{};
+        for (std::uint64_t sent = 0; sent < messages; sent += burst)
+        {
+            for (size_t i = 0; i < burst; ++i)
+                ticks[i] = make_tick(sent + i, skewed);
+            for (size_t routed = 0; routed < burst;)
+            {
+                const auto n = stage.routeBulk(ticks.data() + routed, burst - routed);
+                if (n == 0)
+                    std::this_thread::yield();
+                routed += n;
+            }
+            if (rebalance && (sent + burst) % 4096 == 0)
+                stage.rebalance();
+        }
+        done.store(true, std::memory_order_release);
+        for (auto& t : threads)
+            t.join();
+        benchmark::DoNotOptimize(books.data());
+        st.counters["moves"] = static_cast<double>(stage.moves());
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * messages));
+}
+
+static void mpsc_shared_pool(benchmark::State& st)
+{
+    const auto n_workers = static_cast<size_t>(st.range(0));
+    const bool skewed = st.range(1) != 0;
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        lockedin::MPSCQ<Tick> feed(1024);
+        std::vector<Book> books(instruments);
+        std::mutex pop_lock; // the MPSCQ has a single consumer; the pool shares it
+        std::atomic<bool> done = false;
+        std::vector<std::thread> threads;
+        for (size_t w = 0; w < n_workers; ++w)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    Tick t{};
+                    while (true)
+                    {
+                        bool got = false;
+                        {
+                            std::lock_guard guard(pop_lock);
+                            got = feed.pop(t);
+                        }
+                        if (got)
+                        {
+                            auto& book = books[t.instrument];
+                            std::lock_guard guard(book.lock);
+                            apply(book, t);
+                            continue;
+                        }
+                        if (done.load(std::memory_order_acquire) && feed.empty())
+                            break;
+                        std::this_thread::yield();
+                    }
+                });
+        }
+        st.ResumeTiming();
+
+        for (std::uint64_t sent = 0; sent < messages; ++sent)
+        {
+            const auto t = make_tick(sent, skewed);
+            while (!feed.push(t))
+                std::this_thread::yield();
+        }
+        done.store(true, std::memory_order_release);
+        for (auto& t : threads)
+            t.join();
+        benchmark::DoNotOptimize(books.data());
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * messages));
+}
+
+// {workers, skewed, rebalance}
+BENCHMARK(keyed_dispatcher)
+    ->ArgsProduct({{1, 2, 4}, {0, 1}, {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(mpsc_shared_pool)
+    ->ArgsProduct({{1, 2, 4}, {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
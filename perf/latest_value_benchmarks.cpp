@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/latest_value.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+template <size_t Words> struct Snapshot
+{
+    std::uint64_t fields[Words];
+};
+
+using BookTop = Snapshot<4>;    // 32 B
+using RiskLimits = Snapshot<32>; // 256 B
+
+// Reference point: the obvious mutex-protected value.
+template <typename T> class LockedValue
+{
+public:
+    void store(const T& value)
+    {
+        std::lock_guard lock(mutex_);
+        value_ = value;
+    }
+
+    T load()
+    {
+        std::lock_guard lock(mutex_);
+        return value_;
+    }
+
+private:
+    std::mutex mutex_;
+    T value_{};
+};
+
+template <typename T> struct TripleBufferAdapter
+{
+    lockedin::TripleBuffer<T> buffer;
+    void store(const T& value)
+    {
+        buffer.publish(value);
+    }
+    T load()
+    {
+        return buffer.read();
+    }
+};
+
+template <typename T> struct SeqLockAdapter
+{
+    lockedin::SeqLockCell<T> cell;
+    void store(const T& value)
+    {
+        cell.store(value);
+    }
+    T load()
+    {
+        return cell.load();
+    }
+};
+
+// Writer publish latency, no reader.
+template <typename Cell, typename T> static void writer_publish(benchmark::State& st)
+{
+    Cell cell;
+    T value{};
+    for ([[maybe_unused]] auto _ : st)
+    {
+        ++value.fields[0];
+        cell.store(value);
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+// Reader acquire latency while `range(0)` == 1 adds a writer publishing continuously.
+template <typename Cell, typename T> static void reader_acquire(benchmark::State& st)
+{
+    Cell cell;
+    std::atomic<bool> stop{false};
+    std::thread writer;
+    if (st.range(0) != 0)
+        writer = std::thread(
+            [&]
+            {
+                T value{};
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    ++value.fields[0];
+                    cell.store(value);
+                }
+            });
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        T value = cell.load();
+        benchmark::DoNotOptimize(value);
+    }
+
+    stop.store(true);
+    if (writer.joinable())
+        writer.join();
+    st.SetItemsProcessed(st.iterations());
+}
+
+BENCHMARK(writer_publish<TripleBufferAdapter<BookTop>, BookTop>);
+BENCHMARK(writer_publish<SeqLockAdapter<BookTop>, BookTop>);
+BENCHMARK(writer_publish<LockedValue<BookTop>, BookTop>);
+BENCHMARK(writer_publish<TripleBufferAdapter<RiskLimits>, RiskLimits>);
+BENCHMARK(writer_publish<SeqLockAdapter<RiskLimits>, RiskLimits>);
+BENCHMARK(writer_publish<LockedValue<RiskLimits>, RiskLimits>);
+
+BENCHMARK(reader_acquire<TripleBufferAdapter<BookTop>, BookTop>)->Arg(0)->Arg(1);
+BENCHMARK(reader_acquire<SeqLockAdapter<BookTop>, BookTop>)->Arg(0)->Arg(1);
+BENCHMARK(reader_acquire<LockedValue<BookTop>, BookTop>)->Arg(0)->Arg(1);
+BENCHMARK(reader_acquire<TripleBufferAdapter<RiskLimits>, RiskLimits>)->Arg(0)->Arg(1);
+BENCHMARK(reader_acquire<SeqLockAdapter<RiskLimits>, RiskLimits>)->Arg(0)->Arg(1);
+BENCHMARK(reader_acquire<LockedValue<RiskLimits>, RiskLimits>)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
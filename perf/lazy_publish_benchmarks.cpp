@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/spsc_queue.hpp>
+
+#include "perf_helpers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Eager vs lazy cursor publication on SPSCQ: what batching the index stores buys in
+// throughput and what it costs in latency when the producer is paced.
+
+static constexpr size_t ring_capacity = 4096;
+static constexpr size_t stream_messages = 1 << 20;
+static constexpr size_t paced_messages = 1 << 14;
+
+using clock_type = std::chrono::steady_clock;
+
+template <typename Publish>
+using Queue = lockedin::SPSCQ<std::uint64_t, lockedin::NoStats, Publish>;
+
+// A producer thread pushes as fast as it can; the benchmark thread pops everything.
+template <typename Publish> static void stream_throughput(benchmark::State& st)
+{
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        Queue<Publish> q(ring_capacity);
+        std::atomic<bool> go = false;
+        std::thread producer(
+            [&]
+            {
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (std::uint64_t i = 0; i < stream_messages; ++i)
+                {
+                    while (!q.push(i))
+                        std::this_thread::yield();
+                }
+                q.flush();
+            });
+        st.ResumeTiming();
+
+        go.store(true, std::memory_order_release);
+        std::uint64_t value = 0;
+        for (size_t received = 0; received < stream_messages;)
+        {
+            if (q.pop(value))
+                ++received;
+            else
+                std::this_thread::yield();
+        }
+        benchmark::DoNotOptimize(value);
+
+        st.PauseTiming();
+        producer.join();
+        st.ResumeTiming();
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * stream_messages));
+}
+
+// The producer sends bursts of `range(0)` timestamps spaced `range(1)` ns apart and, with
+// `Flush`, flushes after each burst as a paced feed handler would; the consumer records
+// push-to-pop latency. Without the flush, a burst's tail stays invisible until later pushes
+// complete its batch: the latency cost of a forgotten flush.
+template <typename Publish, bool Flush = true> static void paced_latency(benchmark::State& st)
+{
+    const auto burst = static_cast<size_t>(st.range(0));
+    const auto gap = std::chrono::nanoseconds(st.range(1));
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(paced_messages);
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        latencies.clear();
+        Queue<Publish> q(ring_capacity);
+        std::thread producer(
+            [&]
+            {
+                auto next = clock_type::now();
+                for (size_t sent = 0; sent < paced_messages;)
+                {
+                    for (size_t i = 0; i < burst && sent < paced_messages; ++i, ++sent)
+                    {
+                        const auto now = clock_type::now().time_since_epoch().count();
+                        while (!q.push(static_cast<std::uint64_t>(now)))
+                            std::this_thread::yield();
+                    }
+                    if constexpr (Flush)
+                        q.flush();
+                    next += gap;
+                    while (clock_type::now() < next)
+                        std::this_thread::yield();
+                }
+                q.flush(); // the last partial batch
+            });
+
+        std::uint64_t sent_at = 0;
+        while (latencies.size() < paced_messages)
+        {
+            if (q.pop(sent_at))
+                latencies.push_back(clock_type::now().time_since_epoch().count() -
+                                    static_cast<std::int64_t>(sent_at));
+            else
+                std::this_thread::yield();
+        }
+        producer.join();
+    }
+
+    st.counters["p50_ns"] = percentile(latencies, 0.50);
+    st.counters["p99_ns"] = percentile(latencies, 0.99);
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * paced_messages));
+}
+
+static void paced_shapes(benchmark::internal::Benchmark* b)
+{
+    for (int64_t burst : {1, 16, 256})
+        b->Args({burst, 20'000});
+}
+
+BENCHMARK(stream_throughput<lockedin::EagerPublish>)->UseRealTime();
+BENCHMARK(stream_throughput<lockedin::LazyPublish<8>>)->UseRealTime();
+BENCHMARK(stream_throughput<lockedin::LazyPublish<32>>)->UseRealTime();
+BENCHMARK(stream_throughput<lockedin::LazyPublish<128>>)->UseRealTime();
+
+BENCHMARK(paced_latency<lockedin::EagerPublish>)->Apply(paced_shapes)->UseRealTime();
+BENCHMARK(paced_latency<lockedin::LazyPublish<8>>)->Apply(paced_shapes)->UseRealTime();
+BENCHMARK(paced_latency<lockedin::LazyPublish<32>>)->Apply(paced_shapes)->UseRealTime();
+BENCHMARK(paced_latency<lockedin::LazyPublish<128>>)->Apply(paced_shapes)->UseRealTime();
+BENCHMARK_TEMPLATE(paced_latency, lockedin::LazyPublish<8>, false)
+    ->Apply(paced_shapes)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(paced_latency, lockedin::LazyPublish<32>, false)
+    ->Apply(paced_shapes)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(paced_latency, lockedin::LazyPublish<128>, false)
+    ->Apply(paced_shapes)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
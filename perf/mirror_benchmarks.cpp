@@ -0,0 +1,191 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/byte_ring.hpp>
+#include <lockedin/mirror_buffer.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Contiguous wrap-around access: a mirrored ring against the usual split handling, for
+// length-prefixed variable-length records and for SPSCQ bulk transfers.
+
+static constexpr size_t ring_bytes = 1 << 16;
+
+// Record lengths cycle through 8..(8 + range(0)) bytes so records land on the wrap point at
+// varying offsets.
+static std::uint32_t record_length(std::uint64_t i, std::uint32_t spread)
+{
+    return 8 + static_cast<std::uint32_t>((i * 37) % spread);
+}
+
+// The baseline: a plain byte ring whose writer splits at the end of the buffer and whose
+// reader reassembles wrapped headers and bodies in a scratch buffer.
+class split_byte_ring
+{
+public:
+    explicit split_byte_ring(size_t capacity)
+        : capacity_{capacity}, bytes_{std::make_unique<std::byte[]>(capacity)}
+    {
+    }
+
+    bool write(const void* data, size_t n)
+    {
+        if (write_ + n - read_ > capacity_)
+            return false;
+        copy_in(write_, data, n);
+        write_ += n;
+        return true;
+    }
+
+    // Decodes every complete record; returns the checksum of the bodies.
+    std::uint64_t decode_all(std::vector<std::byte>& scratch)
+    {
+        std::uint64_t sum = 0;
+        std::uint32_t length = 0;
+        while (write_ - read_ >= sizeof(length))
+        {
+            copy_out(&length, read_, sizeof(length));
+            if (write_ - read_ - sizeof(length) < length)
+                break;
+            const auto at = (read_ + sizeof(length)) & (capacity_ - 1);
+            const std::byte* body = &bytes_[at];
+            if (at + length > capacity_)
+            {
+                copy_out(scratch.data(), read_ + sizeof(length), length);
+                body = scratch.data();
+            }
+            sum += static_cast<std::uint64_t>(body[0]) +
+                   static_cast<std::uint64_t>(body[length - 1]);
+            read_ += sizeof(length) + length;
+        }
+        return sum;
+    }
+
+private:
+    void copy_in(std::uint64_t pos, const void* data, size_t n)
+    {
+        const auto at = pos & (capacity_ - 1);
+        const auto first = std::min(n, capacity_ - at);
+        std::memcpy(&bytes_[at], data, first);
+        std::memcpy(&bytes_[0], static_cast<const std::byte*>(data) + first, n - first);
+    }
+
+    void copy_out(void* out, std::uint64_t pos, size_t n) const
+    {
+        const auto at = pos & (capacity_ - 1);
+        const auto first = std::min(n, capacity_ - at);
+        std::memcpy(out, &bytes_[at], first);
+        std::memcpy(static_cast<std::byte*>(out) + first, &bytes_[0], n - first);
+    }
+
+    size_t capacity_;
+    std::unique_ptr<std::byte[]> bytes_;
+    std::uint64_t read_{0};
+    std::uint64_t write_{0};
+};
+
+static std::uint64_t decode_all(lockedin::ByteRing& ring)
+{
+    const auto in = ring.readable();
+    std::uint64_t sum = 0;
+    size_t offset = 0;
+    std::uint32_t length = 0;
+    while (in.size() - offset >= sizeof(length))
+    {
+        std::memcpy(&length, in.data() + offset, sizeof(length));
+        if (in.size() - offset - sizeof(length) < length)
+            break;
+        const std::byte* body = in.data() + offset + sizeof(length);
+        sum += static_cast<std::uint64_t>(body[0]) + static_cast<std::uint64_t>(body[length - 1]);
+        offset += sizeof(length) + length;
+    }
+    ring.consume(offset);
+    return sum;
+}
+
+// Fill the ring with records, then decode them all; one thread, so only the copy and decode
+// cost is measured.
+static void decode_split(benchmark::State& st)
+{
+    const auto spread = static_cast<std::uint32_t>(st.range(0));
+    split_byte_ring ring(ring_bytes);
+    std::vector<std::byte> record(4 + 8 + spread, std::byte{7});
+    std::vector<std::byte> scratch(8 + spread);
+    std::uint64_t i = 0;
+    std::uint64_t bytes = 0;
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        for (;; ++i)
+        {
+            const auto length = record_length(i, spread);
+            std::memcpy(record.data(), &length, sizeof(length));
+            if (!ring.write(record.data(), sizeof(length) + length))
+                break;
+            bytes += sizeof(length) + length;
+        }
+        benchmark::DoNotOptimize(ring.decode_all(scratch));
+    }
+    st.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+static void decode_mirror(benchmark::State& st)
+{
+    const auto spread = static_cast<std::uint32_t>(st.range(0));
+    lockedin::ByteRing ring(ring_bytes);
+    std::vector<std::byte> record(4 + 8 + spread, std::byte{7});
+    std::uint64_t i = 0;
+    std::uint64_t bytes = 0;
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        for (;; ++i)
+        {
+            const auto length = record_length(i, spread);
+            std::memcpy(record.data(), &length, sizeof(length));
+            if (!ring.write(record.data(), sizeof(length) + length))
+                break;
+            bytes += sizeof(length) + length;
+        }
+        benchmark::DoNotOptimize(decode_all(ring));
+    }
+    st.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+struct Tick
+{
+    std::uint64_t fields[8];
+};
+static_assert(sizeof(Tick) == 64);
+
+// Bulk push/pop of `range(0)` ticks with a batch size that does not divide the capacity, so
+// batches keep landing on the wrap point.
+template <typename Storage> static void bulk_wrapping(benchmark::State& st)
+{
+    const auto burst = static_cast<size_t>(st.range(0));
+    lockedin::SPSCQ<Tick, lockedin::NoStats, lockedin::EagerPublish, Storage> q(4096);
+    std::vector<Tick> in(burst, Tick{{1, 2, 3, 4, 5, 6, 7, 8}});
+    std::vector<Tick> out(burst);
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        q.pushBulk(in.data(), burst);
+        q.popBulk(out.data(), burst);
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * burst));
+}
+
+BENCHMARK(decode_split)->Arg(64)->Arg(512)->Arg(4096);
+BENCHMARK(decode_mirror)->Arg(64)->Arg(512)->Arg(4096);
+
+BENCHMARK(bulk_wrapping<lockedin::HeapStorage>)->Arg(7)->Arg(100)->Arg(1000);
+BENCHMARK(bulk_wrapping<lockedin::MirrorStorage>)->Arg(7)->Arg(100)->Arg(1000);
+
+BENCHMARK_MAIN();
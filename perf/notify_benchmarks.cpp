@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/notifying_queue.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// Event-loop consumer: drains, arms, sleeps in epoll_wait, echoes each message back.
+// Returns the system calls it made (epoll_wait and eventfd reads).
+template <typename Queue>
+static std::uint64_t epoll_loop(Queue& q, lockedin::SPSCQ<int>& replies, std::atomic<bool>& stop)
+{
+    std::uint64_t syscalls = 0;
+    const int ep = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ::epoll_ctl(ep, EPOLL_CTL_ADD, q.fd(), &ev);
+
+    int v = 0;
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        while (q.pop(v))
+            while (!replies.push(v))
+                ;
+        if (q.arm())
+        {
+            epoll_event out{};
+            ++syscalls;
+            if (::epoll_wait(ep, &out, 1, 10) > 0)
+            {
+                ++syscalls;
+                q.clear();
+            }
+        }
+    }
+    ::close(ep);
+    return syscalls;
+}
+
+// Low load: one message in flight, so the consumer is asleep every time -> wake latency.
+static void wake_round_trip(benchmark::State& st)
+{
+    lockedin::NotifyingQ<int> q(1024);
+    lockedin::SPSCQ<int> replies(1024);
+    std::atomic<bool> stop{false};
+    std::uint64_t consumerSyscalls = 0;
+    std::thread consumer([&] { consumerSyscalls = epoll_loop(q, replies, stop); });
+
+    int v = 0;
+    for ([[maybe_unused]] auto _ : st)
+    {
+        while (!q.push(1))
+            ;
+        while (!replies.pop(v))
+            ;
+    }
+    stop.store(true);
+    q.push(0);
+    consumer.join();
+
+    st.SetItemsProcessed(st.iterations());
+    st.counters["syscalls_per_msg"] = static_cast<double>(q.wakeups() + consumerSyscalls) /
+                                      static_cast<double>(st.iterations());
+}
+
+// High load: bursts of `range(0)` messages; wakes coalesce while the consumer is draining.
+static void burst_throughput(benchmark::State& st)
+{
+    const auto burst = static_cast<int>(st.range(0));
+    lockedin::NotifyingQ<int> q(4096);
+    lockedin::SPSCQ<int> replies(4096);
+    std::atomic<bool> stop{false};
+    std::uint64_t consumerSyscalls = 0;
+    std::thread consumer([&] { consumerSyscalls = epoll_loop(q, replies, stop); });
+
+    int v = 0;
+    for ([[maybe_unused]] auto _ : st)
+    {
+        for (int i = 0; i < burst; ++i)
+            while (!q.push(i))
+                ;
+        for (int i = 0; i < burst; ++i)
+            while (!replies.pop(v))
+                ;
+    }
+    stop.store(true);
+    q.push(0);
+    consumer.join();
+
+    const auto messages = static_cast<double>(st.iterations()) * burst;
+    st.SetItemsProcessed(static_cast<int64_t>(messages));
+    st.counters["syscalls_per_msg"] =
+        static_cast<double>(q.wakeups() + consumerSyscalls) / messages;
+}
+
+BENCHMARK(wake_round_trip)->UseRealTime();
+BENCHMARK(burst_throughput)->Arg(16)->Arg(256)->Arg(2048)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/object_pool.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+static constexpr size_t pool_capacity = 4096;
+static constexpr size_t queue_capacity = 1024;
+static constexpr size_t messages = 1 << 16;
+
+template <size_t Size> struct Message
+{
+    std::uint64_t id;
+    std::byte payload[Size - sizeof(std::uint64_t)];
+
+    explicit Message(std::uint64_t i) : id{i}
+    {
+    }
+};
+
+// Same thread allocates and frees: the allocator's cache refills from its own releases.
+template <size_t Size> static void pool_alloc_free(benchmark::State& st)
+{
+    lockedin::ObjectPool<Message<Size>> pool(pool_capacity);
+    auto alloc = pool.getAllocator();
+    std::uint64_t i = 0;
+    for ([[maybe_unused]] auto _ : st)
+    {
+        auto p = alloc.make(i++);
+        benchmark::DoNotOptimize(p.get());
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+template <size_t Size> static void malloc_alloc_free(benchmark::State& st)
+{
+    std::uint64_t i = 0;
+    for ([[maybe_unused]] auto _ : st)
+    {
+        auto p = std::make_unique<Message<Size>>(i++);
+        benchmark::DoNotOptimize(p.get());
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+// Producer allocates, consumer frees, pointers travel through an SPSCQ.
+template <typename Ptr, typename Make> static void cross_thread(benchmark::State& st, Make make)
+{
+    for ([[maybe_unused]] auto _ : st)
+    {
+        lockedin::SPSCQ<Ptr> queue(queue_capacity);
+        std::thread consumer(
+            [&]
+            {
+                Ptr p;
+                for (size_t received = 0; received < messages;)
+                    if (queue.pop(p))
+                    {
+                        benchmark::DoNotOptimize(p->id);
+                        p.reset();
+                        ++received;
+                    }
+            });
+
+        for (size_t i = 0; i < messages; ++i)
+        {
+            Ptr p = make(i);
+            while (!p)
+                p = make(i);
+            while (!queue.push(std::move(p)))
+                ;
+        }
+        consumer.join();
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * messages));
+}
+
+template <size_t Size> static void pool_cross_thread(benchmark::State& st)
+{
+    lockedin::ObjectPool<Message<Size>> pool(pool_capacity);
+    auto alloc = pool.getAllocator();
+    cross_thread<lockedin::PooledPtr<Message<Size>>>(st,
+                                                     [&](size_t i) { return alloc.make(i); });
+}
+
+template <size_t Size> static void malloc_cross_thread(benchmark::State& st)
+{
+    cross_thread<std::unique_ptr<Message<Size>>>(
+        st, [](size_t i) { return std::make_unique<Message<Size>>(i); });
+}
+
+BENCHMARK(pool_alloc_free<64>);
+BENCHMARK(malloc_alloc_free<64>);
+BENCHMARK(pool_alloc_free<512>);
+BENCHMARK(malloc_alloc_free<512>);
+BENCHMARK(pool_alloc_free<4096>);
+BENCHMARK(malloc_alloc_free<4096>);
+
+BENCHMARK(pool_cross_thread<64>)->UseRealTime();
+BENCHMARK(malloc_cross_thread<64>)->UseRealTime();
+BENCHMARK(pool_cross_thread<512>)->UseRealTime();
+BENCHMARK(malloc_cross_thread<512>)->UseRealTime();
+BENCHMARK(pool_cross_thread<4096>)->UseRealTime();
+BENCHMARK(malloc_cross_thread<4096>)->UseRealTime();
+
+BENCHMARK_MAIN();
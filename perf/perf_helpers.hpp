@@ -0,0 +1,19 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// Helpers shared by the benchmark binaries.
+
+// Nearest-rank percentile `p` in [0, 1]; reorders `samples`. 0 when there are none.
+template <typename Sample> double percentile(std::vector<Sample>& samples, double p)
+{
+    if (samples.empty())
+        return 0.0;
+    const auto rank = static_cast<size_t>(p * static_cast<double>(samples.size() - 1));
+    const auto nth = samples.begin() + static_cast<std::ptrdiff_t>(rank);
+    std::nth_element(samples.begin(), nth, samples.end());
+    return static_cast<double>(*nth);
+}
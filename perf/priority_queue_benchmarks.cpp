@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/priority_queue.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+static constexpr size_t lanes = 4;
+static constexpr size_t lane_capacity = 1024;
+static constexpr size_t messages_per_producer = 1 << 14;
+
+struct Request
+{
+    std::uint64_t id;
+    std::size_t lane;
+};
+
+// Reference point: std::priority_queue behind a mutex, FIFO within a lane via a sequence.
+class LockedPriorityQueue
+{
+public:
+    bool push(const Request& request, std::size_t lane)
+    {
+        std::lock_guard lock(mutex_);
+        if (heap_.size() >= lanes * lane_capacity)
+            return false;
+        heap_.push(Entry{lane, sequence_++, request});
+        return true;
+    }
+
+    bool pop(Request& out)
+    {
+        std::lock_guard lock(mutex_);
+        if (heap_.empty())
+            return false;
+        out = heap_.top().request;
+        heap_.pop();
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        std::size_t lane;
+        std::uint64_t sequence;
+        Request request;
+
+        bool operator<(const Entry& other) const
+        {
+            return lane != other.lane ? lane > other.lane : sequence > other.sequence;
+        }
+    };
+
+    std::mutex mutex_;
+    std::priority_queue<Entry> heap_;
+    std::uint64_t sequence_{0};
+};
+
+// One thread pushes a burst of `range(0)` requests spread over the lanes, then drains it.
+template <typename Q, typename Make> static void burst(benchmark::State& st, Make make)
+{
+    const auto n = static_cast<std::uint64_t>(st.range(0));
+    auto queue = make();
+    Request out{};
+    for ([[maybe_unused]] auto _ : st)
+    {
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            const auto lane = static_cast<std::size_t>((i * 7) % lanes);
+            queue->push(Request{i, lane}, lane);
+        }
+        while (queue->pop(out))
+            benchmark::DoNotOptimize(out);
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * n));
+}
+
+static void lanes_burst(benchmark::State& st)
+{
+    burst<lockedin::PriorityMPSCQ<Request, lanes>>(
+        st,
+        [] { return std::make_unique<lockedin::PriorityMPSCQ<Request, lanes>>(lane_capacity); });
+}
+
+static void mutex_heap_burst(benchmark::State& st)
+{
+    burst<LockedPriorityQueue>(st, [] { return std::make_unique<LockedPriorityQueue>(); });
+}
+
+// `range(0)` producers, each on its own lane, drained by the benchmark thread.
+template <typename Q, typename Make> static void mixed_lanes(benchmark::State& st, Make make)
+{
+    const size_t n_producers = static_cast<size_t>(st.range(0));
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        auto queue = make();
+        std::atomic<bool> go = false;
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < n_producers; ++p)
+            producers.emplace_back(
+                [&, p]
+                {
+                    while (!go.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                    for (size_t i = 0; i < messages_per_producer; ++i)
+                        while (!queue->push(Request{i, p % lanes}, p % lanes))
+                            std::this_thread::yield();
+                });
+        st.ResumeTiming();
+
+        go.store(true, std::memory_order_release);
+        Request out{};
+        for (size_t received = 0; received < n_producers * messages_per_producer;)
+            if (queue->pop(out))
+                ++received;
+        benchmark::DoNotOptimize(out);
+
+        st.PauseTiming();
+        for (auto& producer : producers)
+            producer.join();
+        st.ResumeTiming();
+    }
+    st.SetItemsProcessed(
+        static_cast<int64_t>(st.iterations() * n_producers * messages_per_producer));
+}
+
+static void lanes_mixed(benchmark::State& st)
+{
+    mixed_lanes<lockedin::PriorityMPSCQ<Request, lanes>>(
+        st,
+        [] { return std::make_unique<lockedin::PriorityMPSCQ<Request, lanes>>(lane_capacity); });
+}
+
+static void mutex_heap_mixed(benchmark::State& st)
+{
+    mixed_lanes<LockedPriorityQueue>(st, [] { return std::make_unique<LockedPriorityQueue>(); });
+}
+
+BENCHMARK(lanes_burst)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(mutex_heap_burst)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(lanes_mixed)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(mutex_heap_mixed)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+BENCHMARK_MAIN();
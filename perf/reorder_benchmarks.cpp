@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/mpsc_queue.hpp>
+#include <lockedin/reorder_buffer.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Resequencing the output of a parallel stateless stage: one dispatcher fans sequenced items
+// round-robin to `range(0)` workers over SPSCQ inboxes, the workers spend an uneven amount of
+// time per item, and the consumer needs the results in input order. The ReorderBuffer is
+// compared with collecting through an MPSCQ and resequencing in a min-heap.
+
+static constexpr std::uint64_t items = 1 << 16;
+static constexpr size_t inbox_capacity = 256;
+
+using clock_type = std::chrono::steady_clock;
+
+static void busy_for(std::chrono::nanoseconds delay)
+{
+    const auto until = clock_type::now() + delay;
+    while (clock_type::now() < until)
+    {
+    }
+}
+
+// Every 8th item costs 10x: enough jitter to reorder results between workers.
+static std::chrono::nanoseconds work_for(std::uint64_t seq)
+{
+    return std::chrono::nanoseconds(seq % 8 == 0 ? 500 : 50);
+}
+
+struct Result
+{
+    std::uint64_t seq;
+    std::uint64_t value;
+};
+
+enum class collector
+{
+    reorder_buffer,
+    mpsc_heap
+};
+
+template <collector How> static void resequence(benchmark::State& st)
+{
+    const auto n_workers = static_cast<size_t>(st.range(0));
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        std::vector<std::unique_ptr<lockedin::SPSCQ<std::uint64_t>>> inboxes;
+        for (size_t w = 0; w < n_workers; ++w)
+            inboxes.push_back(std::make_unique<lockedin::SPSCQ<std::uint64_t>>(inbox_capacity));
+        lockedin::ReorderBuffer<std::uint64_t> rob(n_workers * inbox_capacity * 2);
+        lockedin::MPSCQ<Result> results(n_workers * inbox_capacity * 2);
+        std::atomic<bool> go = false;
+
+        std::vector<std::thread> threads;
+        for (size_t w = 0; w < n_workers; ++w)
+        {
+            threads.emplace_back(
+                [&, w]
+                {
+                    while (!go.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                    std::uint64_t seq = 0;
+                    for (std::uint64_t done = w; done < items; done += n_workers)
+                    {
+                        while (!inboxes[w]->pop(seq))
+                            std::this_thread::yield();
+                        busy_for(work_for(seq));
+                        if constexpr (How == collector::reorder_buffer)
+                        {
+                            while (!rob.deposit(seq, seq ^ 0x5a5a))
+                                std::this_thread::yield();
+                        }
+                        else
+                        {
+                            while (!results.push(Result{seq, seq ^ 0x5a5a}))
+                                std::this_thread::yield();
+                        }
+                    }
+                });
+        }
+        threads.emplace_back(
+            [&]
+            {
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (std::uint64_t seq = 0; seq < items; ++seq)
+                {
+                    while (!inboxes[seq % n_workers]->push(seq))
+                        std::this_thread::yield();
+                }
+            });
+        st.ResumeTiming();
+
+        go.store(true, std::memory_order_release);
+        std::uint64_t next = 0;
+        std::uint64_t checksum = 0;
+        if constexpr (How == collector::reorder_buffer)
+        {
+            while (next < items)
+            {
+                const auto n = rob.drain([&](std::uint64_t&& v, std::uint64_t) { checksum += v; });
+                next += n;
+                if (n == 0)
+                    std::this_thread::yield();
+            }
+        }
+        else
+        {
+            const auto later = [](const Result& a, const Result& b) { return a.seq > b.seq; };
+            std::priority_queue<Result, std::vector<Result>, decltype(later)> pending(later);
+            Result r{};
+            while (next < items)
+            {
+                if (!results.pop(r))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                pending.push(r);
+                while (!pending.empty() && pending.top().seq == next)
+                {
+                    checksum += pending.top().value;
+                    pending.pop();
+                    ++next;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(checksum);
+
+        st.PauseTiming();
+        for (auto& t : threads)
+            t.join();
+        st.ResumeTiming();
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * items));
+}
+
+static void worker_counts(benchmark::internal::Benchmark* b)
+{
+    for (int64_t n : {1, 2, 4, 8})
+        b->Arg(n);
+    b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(resequence<collector::reorder_buffer>)->Apply(worker_counts);
+BENCHMARK(resequence<collector::mpsc_heap>)->Apply(worker_counts);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,204 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/spmc_queue.hpp>
+
+#include "perf_helpers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static constexpr std::uint64_t messages = 1 << 16;
+static constexpr std::uint64_t lag_sample_every = 16;
+
+using clock_type = std::chrono::steady_clock;
+
+// Simulated per-message work of a consumer strategy.
+static void process_for(std::chrono::nanoseconds delay)
+{
+    if (delay.count() == 0)
+        return;
+    const auto until = clock_type::now() + delay;
+    while (clock_type::now() < until)
+    {
+    }
+}
+
+struct ConsumerResult
+{
+    std::uint64_t delivered{0};
+    std::uint64_t overruns{0};
+    std::uint64_t skipped{0}; ///< messages lost to respawns
+    std::vector<double> lags;
+};
+
+// One producer publishes `messages` at full speed into a lossy SPMCQ of capacity `range(1)`;
+// `range(0)` consumers joined at the tail each spend `range(2)` ns per message.
+//
+// Reports per-consumer delivered throughput, the distribution of consumer lag (messages
+// published but not yet read, sampled at pop time), how often `pop` threw because the consumer
+// was overrun, and the fraction of messages lost to the resulting respawns.
+static void spmc_fan_out(benchmark::State& st)
+{
+    const auto n_consumers = static_cast<size_t>(st.range(0));
+    const auto capacity = static_cast<size_t>(st.range(1));
+    const auto delay = std::chrono::nanoseconds(st.range(2));
+
+    std::uint64_t delivered = 0;
+    std::uint64_t overruns = 0;
+    std::uint64_t skipped = 0;
+    std::vector<double> lags;
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        lockedin::SPMCQ<std::uint64_t> queue(capacity);
+        auto producer = queue.getProducer();
+        std::vector<ConsumerResult> results(n_consumers);
+        std::atomic<size_t> ready = 0;
+        std::atomic<bool> go = false;
+
+        std::vector<std::thread> consumers;
+        consumers.reserve(n_consumers);
+        for (size_t c = 0; c < n_consumers; ++c)
+            consumers.emplace_back(
+                [&, c, consumer = queue.getConsumer(lockedin::SPMCJoin::Tail)]() mutable
+                {
+                    auto& result = results[c];
+                    result.lags.reserve(messages / lag_sample_every);
+                    ready.fetch_add(1, std::memory_order_release);
+                    while (!go.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+
+                    std::uint64_t value = 0;
+                    std::uint64_t sequence = 0;
+                    while (consumer.position() < messages)
+                    {
+                        try
+                        {
+                            if (!consumer.pop(value, sequence))
+                                continue;
+                        }
+                        catch (const std::runtime_error&)
+                        {
+                            ++result.overruns;
+                            const auto before = consumer.position();
+                            consumer.respawn();
+                            result.skipped += consumer.position() - before;
+                            continue;
+                        }
+                        ++result.delivered;
+                        if (sequence % lag_sample_every == 0)
+                            result.lags.push_back(
+                                static_cast<double>(queue.sequence() - sequence - 1));
+                        benchmark::DoNotOptimize(value);
+                        process_for(delay);
+                    }
+                });
+        while (ready.load(std::memory_order_acquire) < n_consumers)
+            std::this_thread::yield();
+        st.ResumeTiming();
+
+        go.store(true, std::memory_order_release);
+        for (std::uint64_t i = 0; i < messages; ++i)
+            producer.push(i);
+        for (auto& consumer : consumers)
+            consumer.join();
+
+        st.PauseTiming();
+        for (auto& result : results)
+        {
+            delivered += result.delivered;
+            overruns += result.overruns;
+            skipped += result.skipped;
+            lags.insert(lags.end(), result.lags.begin(), result.lags.end());
+        }
+        st.ResumeTiming();
+    }
+
+    const auto published = static_cast<double>(st.iterations() * messages);
+    const auto expected = published * static_cast<double>(n_consumers);
+    st.SetItemsProcessed(static_cast<int64_t>(published));
+    st.counters["delivered_per_consumer"] = benchmark::Counter(
+        static_cast<double>(delivered) / static_cast<double>(n_consumers),
+        benchmark::Counter::kIsRate);
+    st.counters["lag_p50"] = percentile(lags, 0.50);
+    st.counters["lag_p99"] = percentile(lags, 0.99);
+    st.counters["lag_max"] = lags.empty() ? 0.0 : *std::max_element(lags.begin(), lags.end());
+    st.counters["overruns_per_1k"] = 1000.0 * static_cast<double>(overruns) / expected;
+    st.counters["loss_fraction"] = static_cast<double>(skipped) / expected;
+}
+
+static void fan_out_sweep(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"consumers", "capacity", "delay_ns"});
+    for (const std::int64_t consumers : {1, 2, 4, 8, 16, 32})
+        for (const std::int64_t capacity : {1024, 16384, 262144})
+            for (const std::int64_t delay : {0, 200, 2000})
+                b->Args({consumers, capacity, delay});
+    b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(spmc_fan_out)->Apply(fan_out_sweep);
+
+static constexpr std::uint64_t feed_symbols = 5000;
+static constexpr size_t feed_capacity = 1 << 16;
+
+struct alignas(64) BookUpdate
+{
+    std::uint64_t symbol;
+    std::uint64_t levels[15];
+};
+
+// A 5000-symbol feed pre-published into the ring; one consumer wants `range(0)` of the symbols
+// and either copies every message and filters (`Tagged == false`) or filters on the slot tag
+// and copies only the matches. Single-threaded, so only the consumer's memory traffic shows.
+template <bool Tagged> static void spmc_topic_filter(benchmark::State& st)
+{
+    const auto wanted_symbols = static_cast<std::uint64_t>(st.range(0));
+    lockedin::SPMCQ<BookUpdate> q(feed_capacity);
+    auto producer = q.getProducer();
+    for (std::uint64_t i = 0; i < feed_capacity - 1; ++i)
+    {
+        const auto symbol = (i * 7919) % feed_symbols;
+        producer.push(BookUpdate{symbol, {}}, symbol);
+    }
+    const auto wanted = [&](std::uint64_t symbol) { return symbol < wanted_symbols; };
+
+    std::uint64_t kept = 0;
+    for ([[maybe_unused]] auto _ : st)
+    {
+        auto consumer = q.getConsumer(lockedin::SPMCJoin::Oldest);
+        BookUpdate update{};
+        if constexpr (Tagged)
+        {
+            while (consumer.popMatching(update, wanted))
+                kept += update.symbol < feed_symbols;
+        }
+        else
+        {
+            while (consumer.pop(update))
+                kept += wanted(update.symbol);
+        }
+        benchmark::DoNotOptimize(kept);
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * (feed_capacity - 1)));
+    st.counters["selectivity"] =
+        static_cast<double>(wanted_symbols) / static_cast<double>(feed_symbols);
+}
+
+static void selectivities(benchmark::internal::Benchmark* b)
+{
+    for (const std::int64_t symbols : {5, 50, 500, 5000})
+        b->Arg(symbols);
+}
+
+BENCHMARK(spmc_topic_filter<false>)->Apply(selectivities);
+BENCHMARK(spmc_topic_filter<true>)->Apply(selectivities);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/cpu_topology.hpp>
+#include <lockedin/spmc_queue.hpp>
+#include <lockedin/spmc_relay.hpp>
+
+#include "perf_helpers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Remote-socket consumers reading the producer's ring directly versus through a per-socket
+// relay replica. On a multi-socket host the producer runs on socket 0 and every consumer on
+// the last socket; on a single-socket host the CPUs are split in two halves to emulate the
+// layout (the numbers then show the relay's overhead, not its benefit).
+
+static constexpr std::uint64_t messages = 1 << 16;
+static constexpr size_t ring_capacity = 4096;
+
+using clock_type = std::chrono::steady_clock;
+
+static lockedin::CpuTopology bench_topology()
+{
+    auto detected = lockedin::CpuTopology::detect();
+    if (detected.sockets() >= 2)
+        return detected;
+    const auto& cpus = detected.cpus(0);
+    const auto half = std::max<size_t>(1, cpus.size() / 2);
+    std::vector<int> near(cpus.begin(), cpus.begin() + static_cast<std::ptrdiff_t>(half));
+    std::vector<int> far(cpus.begin() + static_cast<std::ptrdiff_t>(half % cpus.size()),
+                         cpus.end());
+    return lockedin::CpuTopology({near, far});
+}
+
+struct Stamped
+{
+    std::uint64_t sequence;
+    std::int64_t sentAt;
+};
+
+// `range(0)` reliable consumers on the far socket; `Relayed` selects whether they read the
+// primary or the far socket's replica. Reports end-to-end throughput and latency percentiles
+// from publish to pop, sampled on the first consumer.
+template <bool Relayed> static void remote_consumers(benchmark::State& st)
+{
+    const auto n_consumers = static_cast<size_t>(st.range(0));
+    const auto topology = bench_topology();
+    const auto far = topology.sockets() - 1;
+    std::vector<double> latencies;
+
+    for ([[maybe_unused]] auto _ : st)
+    {
+        st.PauseTiming();
+        topology.pinCurrentThread(0);
+        lockedin::SPMCQ<Stamped> primary(ring_capacity, n_consumers + 1);
+        std::unique_ptr<lockedin::SPMCRelay<Stamped, lockedin::YieldingWait>> relay;
+        if constexpr (Relayed)
+            relay = std::make_unique<lockedin::SPMCRelay<Stamped, lockedin::YieldingWait>>(
+                primary, topology, 0, lockedin::SPMCMode::Reliable, ring_capacity,
+                n_consumers);
+        auto& source = Relayed ? relay->ring(far) : primary;
+
+        std::atomic<size_t> joined = 0;
+        std::vector<std::thread> consumers;
+        for (size_t c = 0; c < n_consumers; ++c)
+        {
+            consumers.emplace_back(
+                [&, c]
+                {
+                    topology.pinCurrentThread(far);
+                    auto consumer = source.getConsumer(lockedin::SPMCJoin::Oldest,
+                                                       lockedin::SPMCMode::Reliable);
+                    joined.fetch_add(1, std::memory_order_release);
+                    Stamped m{};
+                    for (std::uint64_t received = 0; received < messages;)
+                    {
+                        if (!consumer.pop(m))
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        if (c == 0 && received % 16 == 0)
+                            latencies.push_back(static_cast<double>(
+                                clock_type::now().time_since_epoch().count() - m.sentAt));
+                        ++received;
+                    }
+                });
+        }
+        while (joined.load(std::memory_order_acquire) != n_consumers)
+            std::this_thread::yield();
+        st.ResumeTiming();
+
+        auto producer = primary.getProducer();
+        for (std::uint64_t i = 0; i < messages; ++i)
+        {
+            const Stamped m{i, clock_type::now().time_since_epoch().count()};
+            while (!producer.push(m))
+                std::this_thread::yield();
+        }
+        for (auto& consumer : consumers)
+            consumer.join();
+
+        st.PauseTiming();
+        relay.reset();
+        st.ResumeTiming();
+    }
+
+    st.counters["p50_ns"] = percentile(latencies, 0.50);
+    st.counters["p99_ns"] = percentile(latencies, 0.99);
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * messages));
+}
+
+static void consumer_counts(benchmark::internal::Benchmark* b)
+{
+    for (int64_t n : {1, 4, 12})
+        b->Arg(n);
+}
+
+BENCHMARK(remote_consumers<false>)->Apply(consumer_counts)->UseRealTime();
+BENCHMARK(remote_consumers<true>)->Apply(consumer_counts)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+
+#include <lockedin/executor.hpp>
+#include <lockedin/wait_strategy.hpp>
+#include <lockedin/work_stealing_scheduler.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+static constexpr size_t n_elements = 1 << 18;
+static constexpr size_t grain = 1024;
+
+// Uniform cost per element, or a cost that grows with the index so static chunking is unfair.
+enum class workload
+{
+    uniform,
+    skewed
+};
+
+template <workload kind> static double element(size_t i)
+{
+    double x = static_cast<double>(i);
+    const size_t rounds = kind == workload::uniform ? 4 : 1 + (i * 16) / n_elements;
+    for (size_t r = 0; r < rounds; ++r)
+        x = std::sqrt(x + 1.0);
+    return x;
+}
+
+template <workload kind> static void parallel_for_serial(benchmark::State& st)
+{
+    std::vector<double> out(n_elements);
+    for ([[maybe_unused]] auto _ : st)
+    {
+        for (size_t i = 0; i < n_elements; ++i)
+            out[i] = element<kind>(i);
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * n_elements));
+}
+
+template <workload kind> static void parallel_for_work_stealing(benchmark::State& st)
+{
+    lockedin::WorkStealingScheduler<> scheduler(static_cast<size_t>(st.range(0)));
+    std::vector<double> out(n_elements);
+    for ([[maybe_unused]] auto _ : st)
+    {
+        scheduler.parallel_for(0, n_elements, grain,
+                               [&](size_t lo, size_t hi)
+                               {
+                                   for (auto i = lo; i < hi; ++i)
+                                       out[i] = element<kind>(i);
+                               });
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * n_elements));
+}
+
+// Baseline: the same chunks pushed round-robin into per-worker MPSCQ inboxes.
+template <workload kind> static void parallel_for_executor_chunks(benchmark::State& st)
+{
+    lockedin::Executor<lockedin::BackoffWait<>> executor(static_cast<size_t>(st.range(0)),
+                                                         n_elements / grain);
+    std::vector<double> out(n_elements);
+    std::atomic<size_t> done = 0;
+    for ([[maybe_unused]] auto _ : st)
+    {
+        done.store(0, std::memory_order_relaxed);
+        for (size_t lo = 0; lo < n_elements; lo += grain)
+            executor.submit(
+                [&out, &done, lo]
+                {
+                    for (auto i = lo; i < lo + grain; ++i)
+                        out[i] = element<kind>(i);
+                    done.fetch_add(1, std::memory_order_release);
+                });
+        while (done.load(std::memory_order_acquire) != n_elements / grain)
+            std::this_thread::yield();
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * n_elements));
+}
+
+BENCHMARK(parallel_for_serial<workload::uniform>)->UseRealTime();
+BENCHMARK(parallel_for_work_stealing<workload::uniform>)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+BENCHMARK(parallel_for_executor_chunks<workload::uniform>)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+BENCHMARK(parallel_for_serial<workload::skewed>)->UseRealTime();
+BENCHMARK(parallel_for_work_stealing<workload::skewed>)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+BENCHMARK(parallel_for_executor_chunks<workload::skewed>)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -1,8 +1,16 @@
 #include <lockedin/abstract_queue.hpp>
+#include <lockedin/mpsc_queue.hpp>
+#include <lockedin/queue_stats.hpp>
 #include <lockedin/spsc_queue.hpp>
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 template <class Q>
     requires lockedin::detail::QueueInterface<Q, int>
@@ -28,10 +36,163 @@ void unitTest(Q& q)
     std::cout << "PASSED\n";
 }
 
+// Disabled telemetry must not change the queue layout.
+static_assert(std::is_empty_v<lockedin::NoStats::producer_side<>>);
+static_assert(std::is_empty_v<lockedin::NoStats::consumer_side>);
+
+template <class Q> void statsTest(Q& q, std::uint64_t usableSlots)
+{
+    while (q.push(1))
+    {
+    }
+
+    int popped = 0;
+    while (q.pop(popped))
+    {
+    }
+
+    const auto stats = q.stats();
+    assert(stats.pushes == usableSlots);
+    assert(stats.pops == usableSlots);
+    assert(stats.fullHits == 1);
+    assert(stats.emptyHits == 1);
+    assert(stats.highWater == usableSlots);
+    assert(stats.occupancySamples == usableSlots);
+    std::cout << "PASSED\n";
+}
+
+struct Tick
+{
+    std::uint64_t sequence;
+    double bid;
+    double ask;
+    std::uint32_t bidSize;
+    std::uint32_t askSize;
+    char symbol[24];
+};
+
+// Bulk transfers across the wrap point, for the memcpy path (trivially copyable, with and
+// without streaming stores) and the element-wise path (std::string).
+template <typename T, lockedin::BulkStore Store, typename Make> void bulkTest(Make make)
+{
+    lockedin::SPSCQ<T, lockedin::QueueStats<1>> q{8}; // 7 usable slots
+    std::vector<T> in;
+    for (std::uint64_t i = 0; i < 10; ++i)
+        in.push_back(make(i));
+    std::vector<T> out(10);
+
+    assert(q.template pushBulk<Store>(in.data(), 5) == 5);
+    assert(q.popBulk(out.data(), 3) == 3);
+    assert(q.template pushBulk<Store>(in.data() + 5, 5) == 5); // wraps: 2 items, then 3
+    assert(q.full());
+    assert(q.template pushBulk<Store>(in.data(), 1) == 0);
+
+    assert(q.popBulk(out.data() + 3, 10) == 7); // wraps on the way out as well
+    assert(q.popBulk(out.data(), 1) == 0);
+    for (std::uint64_t i = 0; i < 10; ++i)
+        assert(out[i] == in[i]);
+
+    const auto stats = q.stats();
+    assert(stats.pushes == 10 && stats.pops == 10);
+    assert(stats.fullHits == 1 && stats.emptyHits == 1);
+    assert(stats.occupancySamples == 2); // one sample per bulk push with SampleEvery = 1
+    std::cout << "PASSED\n";
+}
+
+static bool operator==(const Tick& a, const Tick& b)
+{
+    return a.sequence == b.sequence && a.bid == b.bid;
+}
+
+// Lazy publication: nothing is visible before K pushes or flush(), a full or empty ring hands
+// back what each side holds, and a threaded run still delivers everything in order.
+void lazyPublishTest()
+{
+    lockedin::SPSCQ<int, lockedin::NoStats, lockedin::LazyPublish<4>> q{8}; // 7 usable slots
+    int popped = 0;
+
+    for (int i = 0; i < 3; ++i)
+        assert(q.push(i));
+    assert(q.empty()); // below K: still private to the producer
+    assert(!q.pop(popped));
+    q.flush();
+    assert(q.size() == 3);
+
+    assert(q.push(3)); // the flush restarted the batch
+    assert(q.size() == 3);
+    for (int i = 4; i < 7; ++i)
+        assert(q.push(i)); // 4th push of the batch publishes it
+    assert(q.size() == 7 && q.full());
+    assert(!q.push(7));
+
+    assert(q.pop(popped) && popped == 0);
+    assert(q.pop(popped) && popped == 1);
+    assert(!q.push(7)); // consumed, but not released yet
+    q.release();
+    assert(q.size() == 5);
+    assert(q.push(7) && q.push(8));
+    assert(q.size() == 5);
+    q.flush();
+    assert(q.full());
+
+    for (int expected = 2; expected < 9; ++expected)
+        assert(q.pop(popped) && popped == expected);
+    assert(!q.pop(popped) && q.empty());
+
+    lockedin::SPSCQ<std::uint64_t, lockedin::NoStats, lockedin::LazyPublish<32>> ring{256};
+    constexpr std::uint64_t count = 200'000;
+    std::thread producer([&] {
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            while (!ring.push(i))
+                std::this_thread::yield();
+            if (i % 1000 == 999)
+                ring.flush(); // a paced producer flushes after each burst
+        }
+        ring.flush();
+    });
+
+    std::uint64_t value = 0;
+    for (std::uint64_t expected = 0; expected < count; ++expected)
+    {
+        while (!ring.pop(value))
+            std::this_thread::yield();
+        assert(value == expected);
+    }
+    producer.join();
+    assert(!ring.pop(value));
+
+    bool threw = false;
+    try
+    {
+        lockedin::SPSCQ<int, lockedin::NoStats, lockedin::LazyPublish<8>> tiny{8}; // K >= capacity
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "PASSED\n";
+}
+
 int main()
 {
     lockedin::SPSCQ<int> stub{4};
     unitTest(stub);
 
+    lockedin::SPSCQ<int, lockedin::QueueStats<1>> spsc{4};
+    statsTest(spsc, 3); // one slot stays empty to tell full from empty
+
+    lockedin::MPSCQ<int, lockedin::QueueStats<1>> mpsc{4};
+    statsTest(mpsc, 4);
+
+    const auto tick = [](std::uint64_t i) { return Tick{i, 100.0 + double(i), 100.5, 1, 1, {}}; };
+    bulkTest<Tick, lockedin::BulkStore::Cached>(tick);
+    bulkTest<Tick, lockedin::BulkStore::Streaming>(tick);
+    bulkTest<std::string, lockedin::BulkStore::Cached>(
+        [](std::uint64_t i) { return std::string(40, char('a' + i)); });
+
+    lazyPublishTest();
+
     return 0;
 }
@@ -0,0 +1,165 @@
+#include <lockedin/async_queue.hpp>
+#include <lockedin/mpsc_queue.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using lockedin::AsyncQ;
+using lockedin::CoScheduler;
+using lockedin::CoTask;
+
+// Two coroutines bounce a counter through two tiny rings; each side suspends on every hop.
+static void ping_pong()
+{
+    CoScheduler sched;
+    AsyncQ<int, lockedin::SPSCQ<int>> ping(sched, 2);
+    AsyncQ<int, lockedin::SPSCQ<int>> pong(sched, 2);
+    int last = 0;
+
+    // Coroutine lambdas refer to their closure, so the closures outlive run().
+    auto server = [&]() -> CoTask
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            co_await ping.async_push(i);
+            last = co_await pong.async_pop();
+            assert(last == i + 1);
+        }
+    };
+    auto echo = [&]() -> CoTask
+    {
+        for (int i = 0; i < 1000; ++i)
+            co_await pong.async_push(co_await ping.async_pop() + 1);
+    };
+    sched.spawn(server());
+    sched.spawn(echo());
+
+    sched.run();
+    assert(last == 1000);
+    assert(sched.live() == 0);
+}
+
+// Thousands of producer tasks share one small ring with a single consumer task.
+static void many_tasks_share_a_queue()
+{
+    constexpr int producers = 2000;
+    constexpr int perProducer = 5;
+    CoScheduler sched;
+    AsyncQ<std::uint64_t, lockedin::MPSCQ<std::uint64_t>> q(sched, 16);
+    std::uint64_t sum = 0;
+
+    auto produce = [&q](std::uint64_t id) -> CoTask
+    {
+        for (int i = 0; i < perProducer; ++i)
+            co_await q.async_push(id);
+    };
+    auto consume = [&]() -> CoTask
+    {
+        for (int i = 0; i < producers * perProducer; ++i)
+            sum += co_await q.async_pop();
+    };
+    for (int p = 0; p < producers; ++p)
+        sched.spawn(produce(static_cast<std::uint64_t>(p)));
+    sched.spawn(consume());
+
+    sched.run();
+    const auto n = static_cast<std::uint64_t>(producers);
+    assert(sum == perProducer * n * (n - 1) / 2);
+}
+
+// A plain thread feeds the queue; the scheduler notices by polling.
+static void cross_thread_producer_wakes_consumer()
+{
+    constexpr int n = 20'000;
+    CoScheduler sched;
+    AsyncQ<int, lockedin::MPSCQ<int>> q(sched, 64);
+    int received = 0;
+
+    auto consume = [&]() -> CoTask
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const int v = co_await q.async_pop();
+            assert(v == i);
+            ++received;
+        }
+    };
+    sched.spawn(consume());
+
+    std::thread producer(
+        [&]
+        {
+            for (int i = 0; i < n; ++i)
+                while (!q.push(i))
+                    std::this_thread::yield();
+        });
+
+    sched.run();
+    producer.join();
+    assert(received == n);
+}
+
+static void exceptions_surface_from_run()
+{
+    CoScheduler sched;
+    sched.spawn([]() -> CoTask
+                {
+                    throw std::runtime_error("boom");
+                    co_return;
+                }());
+    bool threw = false;
+    try
+    {
+        sched.run();
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// A task parked on a queue when the scheduler goes away has its frame (and locals) freed.
+static void destroying_the_scheduler_frees_parked_tasks()
+{
+    auto token = std::make_shared<int>(0);
+    {
+        CoScheduler sched;
+        AsyncQ<int, lockedin::SPSCQ<int>> q(sched, 2);
+        sched.spawn([](AsyncQ<int, lockedin::SPSCQ<int>>& queue,
+                       std::shared_ptr<int> held) -> CoTask
+                    { *held += co_await queue.async_pop(); }(q, token));
+        sched.spawn([]() -> CoTask
+                    {
+                        throw std::runtime_error("stop");
+                        co_return;
+                    }());
+        try
+        {
+            sched.run();
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        assert(token.use_count() == 2 && sched.live() == 1); // still parked
+    }
+    assert(token.use_count() == 1);
+}
+
+int main()
+{
+    ping_pong();
+    many_tasks_share_a_queue();
+    cross_thread_producer_wakes_consumer();
+    exceptions_surface_from_run();
+    destroying_the_scheduler_frees_parked_tasks();
+
+    std::cout << "PASSED\n";
+    return 0;
+}
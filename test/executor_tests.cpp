@@ -0,0 +1,100 @@
+#include <lockedin/executor.hpp>
+#include <lockedin/inplace_function.hpp>
+#include <lockedin/wait_strategy.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+static void inplace_function_moves_and_destroys()
+{
+    auto shared = std::make_shared<int>(7);
+    {
+        lockedin::InplaceFunction<int(int), 32> fn = [shared](int x) { return *shared + x; };
+        assert(shared.use_count() == 2);
+
+        lockedin::InplaceFunction<int(int), 32> moved = std::move(fn);
+        assert(!fn);
+        assert(moved(1) == 8);
+        assert(shared.use_count() == 2);
+
+        moved.reset();
+        assert(shared.use_count() == 1);
+
+        bool threw = false;
+        try
+        {
+            moved(1);
+        }
+        catch (const std::bad_function_call&)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+    assert(shared.use_count() == 1);
+}
+
+template <typename Wait> static void runs_every_task()
+{
+    constexpr int tasks = 10000;
+    std::atomic<int> done{0};
+    {
+        lockedin::Executor<Wait> executor(3, 64);
+        for (int i = 0; i < tasks; ++i)
+            executor.submit([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+    } // destructor drains before joining
+    assert(done.load() == tasks);
+}
+
+// Tasks pinned to one worker run in submission order.
+static void pinned_tasks_keep_order()
+{
+    constexpr int tasks = 5000;
+    std::vector<int> seen;
+    seen.reserve(tasks);
+    {
+        lockedin::Executor<lockedin::YieldingWait> executor(2, 128);
+        for (int i = 0; i < tasks; ++i)
+            executor.submitTo(1, [&seen, i] { seen.push_back(i); });
+    }
+    assert(static_cast<int>(seen.size()) == tasks);
+    for (int i = 0; i < tasks; ++i)
+        assert(seen[i] == i);
+}
+
+static void try_submit_reports_full_inbox()
+{
+    std::atomic<bool> release{false};
+    lockedin::Executor<lockedin::YieldingWait> executor(1, 2);
+    executor.submit([&release]
+                    {
+                        while (!release.load())
+                            std::this_thread::yield();
+                    });
+
+    int accepted = 0;
+    for (int i = 0; i < 16; ++i)
+        accepted += executor.trySubmitTo(0, [] {}) ? 1 : 0;
+    assert(accepted < 16);
+
+    release = true;
+    executor.shutdown();
+}
+
+int main()
+{
+    inplace_function_moves_and_destroys();
+    runs_every_task<lockedin::BusySpinWait>();
+    runs_every_task<lockedin::YieldingWait>();
+    runs_every_task<lockedin::BackoffWait<>>();
+    runs_every_task<lockedin::BlockingWait<>>();
+    pinned_tasks_keep_order();
+    try_submit_reports_full_inbox();
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <lockedin/fan_in_queue.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct Tick
+{
+    std::uint64_t timestamp{0};
+    int producer{0};
+};
+
+static void round_robin_interleaves_producers()
+{
+    lockedin::FanInQ<int> q{3, 8};
+    auto p0 = q.getProducer(0);
+    auto p2 = q.getProducer(2);
+    assert(p0.push(1) && p0.push(2));
+    assert(p2.push(10) && p2.push(20));
+
+    int v = 0;
+    assert(q.pop(v) && v == 1);
+    assert(q.pop(v) && v == 10);
+    assert(q.pop(v) && v == 2);
+    assert(q.pop(v) && v == 20);
+    assert(!q.pop(v));
+    assert(q.empty());
+}
+
+static void weighted_serves_bursts()
+{
+    lockedin::FanInQ<int, lockedin::WeightedMerge> q{2, 16, lockedin::WeightedMerge({3, 1})};
+    auto heavy = q.getProducer(0);
+    auto light = q.getProducer(1);
+    for (int i = 0; i < 6; ++i)
+    {
+        assert(heavy.push(0));
+        assert(light.push(1));
+    }
+
+    std::vector<int> order;
+    int v = 0;
+    while (q.pop(v))
+        order.push_back(v);
+    const std::vector<int> expected{0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 1, 1};
+    assert(order == expected);
+
+    bool threw = false;
+    try
+    {
+        lockedin::FanInQ<int, lockedin::WeightedMerge> bad{3, 16, lockedin::WeightedMerge({3, 1})};
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+static void timestamp_merge_orders_fronts()
+{
+    auto key = [](const Tick& t) { return t.timestamp; };
+    lockedin::FanInQ<Tick, lockedin::TimestampMerge<decltype(key)>> q{
+        3, 8, lockedin::TimestampMerge<decltype(key)>(key)};
+    auto a = q.getProducer(0);
+    auto b = q.getProducer(1);
+    auto c = q.getProducer(2);
+    assert(a.push({1, 0}) && a.push({5, 0}) && a.push({9, 0}));
+    assert(b.push({2, 1}) && b.push({3, 1}) && b.push({8, 1}));
+    assert(c.push({4, 2}) && c.push({7, 2}));
+
+    Tick t;
+    std::uint64_t last = 0;
+    int n = 0;
+    while (q.pop(t))
+    {
+        assert(t.timestamp >= last);
+        last = t.timestamp;
+        ++n;
+    }
+    assert(n == 8);
+}
+
+// Many producers (more than one summary word), each stream stays in order.
+static void concurrent_producers_keep_per_producer_order()
+{
+    constexpr int producers = 70;
+    constexpr int perProducer = 2000;
+    lockedin::FanInQ<Tick> q{producers, 64};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back(
+            [&q, p]
+            {
+                auto handle = q.getProducer(p);
+                for (int i = 0; i < perProducer; ++i)
+                    while (!handle.push({static_cast<std::uint64_t>(i), p}))
+                        std::this_thread::yield();
+            });
+
+    std::vector<std::uint64_t> next(producers, 0);
+    Tick t;
+    for (int received = 0; received < producers * perProducer;)
+    {
+        if (!q.pop(t))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        assert(t.timestamp == next[t.producer]);
+        ++next[t.producer];
+        ++received;
+    }
+    for (auto& th : threads)
+        th.join();
+    assert(q.empty());
+}
+
+int main()
+{
+    round_robin_interleaves_producers();
+    weighted_serves_bursts();
+    timestamp_merge_orders_fronts();
+    concurrent_producers_keep_per_producer_order();
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <lockedin/journal_queue.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+struct Fill
+{
+    std::uint64_t orderId{0};
+    double price{0};
+    std::int32_t quantity{0};
+};
+
+static fs::path scratch(const std::string& name)
+{
+    auto dir = fs::temp_directory_path() /
+               ("lockedin-journal-" + std::to_string(::getpid()) + "-" + name);
+    fs::remove_all(dir);
+    return dir;
+}
+
+static void append_and_tail()
+{
+    const auto dir = scratch("tail");
+    lockedin::JournalQ<Fill> journal(dir, 8);
+    lockedin::JournalReader<Fill> reader(dir);
+
+    Fill f{};
+    assert(!reader.pop(f));
+    for (std::uint64_t i = 0; i < 3; ++i)
+        assert(journal.push(Fill{i, 100.5 + static_cast<double>(i), 10}));
+
+    for (std::uint64_t i = 0; i < 3; ++i)
+        assert(reader.pop(f) && f.orderId == i && f.price == 100.5 + static_cast<double>(i));
+    assert(!reader.pop(f));
+    assert(journal.sequence() == 3 && reader.sequence() == 3);
+    fs::remove_all(dir);
+}
+
+static void rolls_over_segments_and_replays_after_restart()
+{
+    const auto dir = scratch("restart");
+    {
+        lockedin::JournalQ<Fill, lockedin::SyncEvery<4>> journal(dir, 4);
+        for (std::uint64_t i = 0; i < 10; ++i)
+            assert(journal.push(Fill{i, 0, 1}));
+    }
+    std::size_t segments = 0;
+    for ([[maybe_unused]] const auto& entry : fs::directory_iterator(dir))
+        ++segments;
+    assert(segments == 4); // three written, the next one prepared ahead
+
+    {
+        lockedin::JournalQ<Fill> journal(dir, 4); // resumes after the last committed record
+        assert(journal.sequence() == 10);
+        for (std::uint64_t i = 10; i < 13; ++i)
+            assert(journal.push(Fill{i, 0, 1}));
+        journal.flush();
+    }
+
+    lockedin::JournalReader<Fill> replay(dir);
+    Fill f{};
+    for (std::uint64_t i = 0; i < 13; ++i)
+        assert(replay.pop(f) && f.orderId == i);
+    assert(!replay.pop(f));
+
+    lockedin::JournalReader<Fill> fromMiddle(dir, 6);
+    assert(fromMiddle.pop(f) && f.orderId == 6);
+    fromMiddle.seek(11);
+    assert(fromMiddle.pop(f) && f.orderId == 11);
+    fs::remove_all(dir);
+}
+
+static void invalid_segment_size_throws()
+{
+    bool threw = false;
+    try
+    {
+        lockedin::JournalQ<Fill> journal(scratch("invalid"), 6);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+static void live_reader_follows_producer()
+{
+    constexpr std::uint64_t n = 50'000;
+    const auto dir = scratch("live");
+    lockedin::JournalQ<Fill, lockedin::NoSync> journal(dir, 1024);
+
+    std::thread reader(
+        [&]
+        {
+            lockedin::JournalReader<Fill> tail(dir);
+            Fill f{};
+            for (std::uint64_t expected = 0; expected < n;)
+            {
+                if (!tail.pop(f))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                assert(f.orderId == expected);
+                ++expected;
+            }
+        });
+
+    for (std::uint64_t i = 0; i < n; ++i)
+        journal.push(Fill{i, 1.0, 1});
+    reader.join();
+
+    journal.removeSegmentsBefore(n - 1);
+    assert(!fs::exists(dir / "00000000000000000000.journal"));
+    fs::remove_all(dir);
+}
+
+int main()
+{
+    append_and_tail();
+    rolls_over_segments_and_replays_after_restart();
+    invalid_segment_size_throws();
+    live_reader_follows_producer();
+
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -0,0 +1,250 @@
+#include <lockedin/keyed_dispatcher.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct Tick
+{
+    std::uint32_t instrument;
+    std::uint64_t seq; ///< per instrument, from 1
+};
+
+using Dispatcher = lockedin::KeyedDispatcher<Tick, decltype(&Tick::instrument)>;
+
+static void keys_stick_to_one_worker()
+{
+    Dispatcher stage(2, 32, &Tick::instrument, 8);
+    const auto w = stage.owner(7);
+    auto worker = stage.getWorker(w);
+    auto other = stage.getWorker(1 - w);
+
+    Tick batch[34];
+    for (std::uint64_t i = 0; i < 34; ++i)
+        batch[i] = {7, i + 1};
+    assert(stage.routeBulk(batch, 34) == 31); // inbox holds capacity - 1
+    assert(other.empty());
+
+    Tick t{};
+    for (std::uint64_t i = 1; i <= 31; ++i)
+        assert(worker.pop(t) && t.instrument == 7 && t.seq == i);
+    assert(!worker.pop(t));
+    assert(stage.route(batch[31]) && worker.pop(t) && t.seq == 32);
+
+    bool threw = false;
+    try
+    {
+        Dispatcher bad(4, 16, &Tick::instrument, 2);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+static void hot_bucket_moves_after_old_owner_finishes()
+{
+    Dispatcher stage(2, 32, &Tick::instrument, 8);
+
+    // Two instruments on worker 0, in different buckets.
+    std::uint32_t a = 0;
+    while (stage.owner(a) != 0)
+        ++a;
+    std::uint32_t b = a + 1;
+    while (stage.owner(b) != 0 || stage.bucket(b) == stage.bucket(a))
+        ++b;
+
+    for (std::uint64_t i = 1; i <= 8; ++i)
+        assert(stage.route({a, i}) && stage.route({b, i}));
+    assert(stage.rebalance() == 1 && stage.moves() == 1);
+    assert(stage.owner(a) == 0 && stage.owner(b) == 0); // worker 0 still holds their messages
+
+    // The moving instrument is held back; the other one still queues behind worker 0's backlog.
+    const bool routedA = stage.route({a, 9});
+    const bool routedB = stage.route({b, 9});
+    assert(routedA != routedB);
+    const auto mover = routedA ? b : a;
+    auto w0 = stage.getWorker(0);
+    auto w1 = stage.getWorker(1);
+    assert(w1.empty());
+
+    Tick t{};
+    std::size_t drained = 0;
+    while (w0.pop(t))
+        ++drained;
+    assert(drained == 17);
+
+    // Worker 0 has finished the mover's messages, so it switches to worker 1.
+    assert(stage.owner(mover) == 1 && stage.owner(routedA ? a : b) == 0);
+    assert(stage.route({mover, 9}) && w1.pop(t) && t.instrument == mover && t.seq == 9);
+
+    // A single hot instrument cannot be split.
+    for (std::uint64_t i = 10; i < 200; ++i)
+        assert(stage.route({mover, i}) && w1.pop(t));
+    assert(stage.rebalance() == 0);
+}
+
+// The old owner never drains while other keys keep its inbox busy; the move still completes as
+// soon as it has finished the moving bucket's last message.
+static void move_completes_while_old_owner_stays_backlogged()
+{
+    Dispatcher stage(2, 32, &Tick::instrument, 8);
+    std::uint32_t a = 0;
+    while (stage.owner(a) != 0)
+        ++a;
+    std::uint32_t b = a + 1;
+    while (stage.owner(b) != 0 || stage.bucket(b) == stage.bucket(a))
+        ++b;
+
+    for (std::uint64_t i = 1; i <= 8; ++i)
+        assert(stage.route({a, i}) && stage.route({b, i}));
+    assert(stage.rebalance() == 1);
+    const auto mover = stage.route({a, 9}) ? b : a;
+    const auto stayer = mover == a ? b : a;
+    auto w0 = stage.getWorker(0);
+    auto w1 = stage.getWorker(1);
+
+    // Each round worker 0 takes one message and the stayer adds one, so its backlog stays put.
+    Tick t{};
+    std::uint64_t next = 9 + (stayer == a);
+    std::size_t rounds = 0;
+    while (!stage.route({mover, 9}))
+    {
+        assert(w1.empty() && w0.pop(t));
+        assert(t.instrument == stayer || t.seq <= 8);
+        assert(stage.route({stayer, next++}));
+        assert(++rounds <= 17);
+    }
+    assert(!w0.empty());
+    assert(w1.pop(t) && t.instrument == mover && t.seq == 9);
+}
+
+// A bucket moved back before any of its messages reached the new owner must not wait on the
+// count it had at the owner before.
+static void bucket_moves_twice()
+{
+    Dispatcher stage(2, 32, &Tick::instrument, 8);
+    std::uint32_t a = 0;
+    while (stage.owner(a) != 0)
+        ++a;
+    std::uint32_t b = a + 1;
+    while (stage.owner(b) != 0 || stage.bucket(b) == stage.bucket(a))
+        ++b;
+    std::uint32_t c = 0;
+    while (stage.owner(c) != 1)
+        ++c;
+    auto w0 = stage.getWorker(0);
+    auto w1 = stage.getWorker(1);
+    Tick t{};
+
+    // `a` is the hottest bucket of worker 0 and moves to worker 1 once worker 0 is drained.
+    for (std::uint64_t i = 1; i <= 4; ++i)
+        assert(stage.route({b, i}));
+    for (std::uint64_t i = 1; i <= 8; ++i)
+        assert(stage.route({a, i}));
+    assert(stage.rebalance() == 1);
+    while (w0.pop(t))
+    {
+    }
+    assert(stage.owner(a) == 1);
+
+    // A little traffic on worker 1, none of it `a`'s, tips the balance back.
+    for (std::uint64_t i = 1; i <= 3; ++i)
+        assert(stage.route({c, i}));
+    while (w1.pop(t))
+    {
+    }
+    assert(stage.rebalance() >= 1);
+    assert(stage.owner(a) == 0);
+    assert(stage.route({a, 9}) && w0.pop(t) && t.instrument == a && t.seq == 9);
+}
+
+// Skewed traffic over four workers with frequent rebalancing: every instrument is processed by
+// one worker at a time and in sequence order, whichever worker owns it.
+static void per_key_order_survives_rebalancing()
+{
+    constexpr std::uint64_t count = 200'000;
+    constexpr std::uint32_t instruments = 64;
+    constexpr std::size_t workers = 4;
+    Dispatcher stage(workers, 64, &Tick::instrument, 64);
+
+    std::vector<std::atomic<std::uint64_t>> last(instruments);
+    std::vector<std::atomic<bool>> busy(instruments);
+    std::atomic<std::uint64_t> processed = 0;
+    std::atomic<bool> done = false;
+
+    std::vector<std::thread> threads;
+    for (std::size_t w = 0; w < workers; ++w)
+    {
+        threads.emplace_back(
+            [&, w]
+            {
+                auto in = stage.getWorker(w);
+                Tick t{};
+                while (true)
+                {
+                    if (!in.pop(t))
+                    {
+                        if (done.load(std::memory_order_acquire) && in.empty())
+                            break;
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    assert(!busy[t.instrument].exchange(true, std::memory_order_relaxed));
+                    assert(last[t.instrument].load(std::memory_order_relaxed) + 1 == t.seq);
+                    last[t.instrument].store(t.seq, std::memory_order_relaxed);
+                    busy[t.instrument].store(false, std::memory_order_relaxed);
+                    processed.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+    }
+
+    std::vector<std::uint64_t> next(instruments, 1);
+    Tick batch[32];
+    for (std::uint64_t sent = 0; sent < count;)
+    {
+        for (auto& t : batch)
+        {
+            // Four hot instruments take half of the traffic; the hot set shifts over time.
+            const auto r = (sent + static_cast<std::uint64_t>(&t - batch)) * 2654435761u;
+            const auto hot = sent / 16384 * 4;
+            const auto instrument = static_cast<std::uint32_t>(
+                (r % 2 == 0 ? hot + (r >> 8) % 4 : (r >> 8)) % instruments);
+            t = {instrument, next[instrument]++};
+        }
+        for (std::size_t routed = 0; routed < 32;)
+        {
+            const auto n = stage.routeBulk(batch + routed, 32 - routed);
+            if (n == 0)
+                std::this_thread::yield();
+            routed += n;
+        }
+        sent += 32;
+        if (sent % 4096 == 0)
+            stage.rebalance();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : threads)
+        t.join();
+
+    assert(processed.load() == count);
+    for (std::uint32_t i = 0; i < instruments; ++i)
+        assert(last[i].load() == next[i] - 1);
+}
+
+int main()
+{
+    keys_stick_to_one_worker();
+    hot_bucket_moves_after_old_owner_finishes();
+    move_completes_while_old_owner_stays_backlogged();
+    bucket_moves_twice();
+    per_key_order_survives_rebalancing();
+
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <lockedin/latest_value.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+struct Limits
+{
+    std::uint64_t version;
+    std::uint64_t maxPosition;
+    std::uint64_t maxOrderSize;
+    std::uint64_t check; // version ^ maxPosition ^ maxOrderSize
+};
+
+static Limits makeLimits(std::uint64_t v)
+{
+    return Limits{v, v * 10, v * 3, v ^ (v * 10) ^ (v * 3)};
+}
+
+static bool consistent(const Limits& l)
+{
+    return (l.version ^ l.maxPosition ^ l.maxOrderSize) == l.check;
+}
+
+static void triple_buffer_keeps_the_newest()
+{
+    lockedin::TripleBuffer<int> tb(7);
+    assert(tb.read() == 7 && !tb.pending());
+
+    tb.publish(1);
+    tb.publish(2);
+    tb.writeBuffer() = 3;
+    assert(tb.pending() && tb.read() == 2); // 3 is not published yet
+    assert(!tb.update());
+
+    tb.publish();
+    assert(tb.read() == 3);
+    assert(tb.read() == 3);
+}
+
+static void seqlock_cell_versions()
+{
+    lockedin::SeqLockCell<Limits> cell(makeLimits(0));
+    assert(cell.version() == 0 && cell.load().version == 0);
+    cell.store(makeLimits(1));
+    cell.store(makeLimits(2));
+    assert(cell.version() == 2 && cell.load().maxPosition == 20);
+}
+
+// Readers must never observe a torn value, and what they see only moves forward.
+template <typename Read> static void hammer(auto& publish, Read read, int readers)
+{
+    constexpr std::uint64_t n = 100'000;
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r)
+        threads.emplace_back(
+            [&]
+            {
+                std::uint64_t last = 0;
+                while (!done.load(std::memory_order_acquire))
+                {
+                    const Limits l = read();
+                    assert(consistent(l) && l.version >= last);
+                    last = l.version;
+                }
+            });
+
+    for (std::uint64_t v = 1; v <= n; ++v)
+        publish(makeLimits(v));
+    done.store(true, std::memory_order_release);
+    for (auto& t : threads)
+        t.join();
+}
+
+static void concurrent_readers_see_whole_values()
+{
+    lockedin::TripleBuffer<Limits> tb(makeLimits(0));
+    auto publishTb = [&](const Limits& l) { tb.publish(l); };
+    hammer(publishTb, [&] { return tb.read(); }, 1);
+    assert(tb.read().version == 100'000);
+
+    lockedin::SeqLockCell<Limits> cell(makeLimits(0));
+    auto publishCell = [&](const Limits& l) { cell.store(l); };
+    hammer(publishCell, [&] { return cell.load(); }, 3);
+    assert(cell.load().version == 100'000);
+}
+
+int main()
+{
+    triple_buffer_keeps_the_newest();
+    seqlock_cell_versions();
+    concurrent_readers_see_whole_values();
+
+    std::cout << "PASSED\n";
+    return 0;
+}
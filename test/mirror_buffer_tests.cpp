@@ -0,0 +1,125 @@
+#include <lockedin/byte_ring.hpp>
+#include <lockedin/mirror_buffer.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void mirror_aliases_both_halves()
+{
+    const auto page = lockedin::MirrorBuffer::pageSize();
+    lockedin::MirrorBuffer mirror(2 * page);
+    auto* base = mirror.data();
+
+    base[0] = std::byte{0x11};
+    assert(base[2 * page] == std::byte{0x11});
+    base[4 * page - 1] = std::byte{0x22}; // last byte of the second half
+    assert(base[2 * page - 1] == std::byte{0x22});
+
+    bool threw = false;
+    try
+    {
+        lockedin::MirrorBuffer odd(page + 1);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+static void spsc_on_mirror_storage()
+{
+    const auto capacity = lockedin::MirrorBuffer::pageSize() / sizeof(std::uint64_t);
+    lockedin::SPSCQ<std::uint64_t, lockedin::NoStats, lockedin::EagerPublish,
+                    lockedin::MirrorStorage>
+        q(capacity);
+
+    std::vector<std::uint64_t> in(capacity), out(capacity);
+    for (std::uint64_t i = 0; i < capacity; ++i)
+        in[i] = i;
+
+    // Move the cursors close to the end, then push a batch across the wrap point.
+    assert(q.pushBulk(in.data(), capacity - 10) == capacity - 10);
+    assert(q.popBulk(out.data(), capacity - 10) == capacity - 10);
+    assert(q.pushBulk(in.data(), 30) == 30);
+
+    auto items = q.readable(); // one span, although the items wrap
+    assert(items.size() == 30);
+    for (std::uint64_t i = 0; i < 30; ++i)
+        assert(items[i] == i);
+    q.consume(20);
+    assert(q.size() == 10);
+
+    std::uint64_t value = 0;
+    assert(q.pop(value) && value == 20);
+    assert(q.popBulk(out.data(), capacity) == 9 && out[8] == 29);
+    assert(q.readable().empty());
+}
+
+// Length-prefixed records of 1..300 bytes streamed through a small ring; the consumer decodes
+// them in place, including the ones split across the end of the buffer.
+static void byte_ring_streams_variable_length_records()
+{
+    lockedin::ByteRing ring(lockedin::MirrorBuffer::pageSize());
+    constexpr std::uint32_t records = 50'000;
+
+    std::thread producer([&] {
+        for (std::uint32_t i = 0; i < records; ++i)
+        {
+            const std::uint32_t length = 1 + i % 300;
+            std::span<std::byte> out;
+            while ((out = ring.prepare(sizeof(length) + length)).empty())
+                std::this_thread::yield();
+            std::memcpy(out.data(), &length, sizeof(length));
+            std::memset(out.data() + sizeof(length), int(i & 0xff), length);
+            ring.commit(out.size());
+        }
+    });
+
+    std::uint32_t decoded = 0;
+    std::uint64_t position = 0; // bytes decoded so far
+    std::uint64_t wrapped = 0;
+    while (decoded < records)
+    {
+        const auto in = ring.readable();
+        std::size_t offset = 0;
+        std::uint32_t length = 0;
+        while (in.size() - offset >= sizeof(length))
+        {
+            std::memcpy(&length, in.data() + offset, sizeof(length));
+            if (in.size() - offset - sizeof(length) < length)
+                break; // incomplete record
+            const auto* body = in.data() + offset + sizeof(length);
+            assert(length == 1 + decoded % 300);
+            assert(body[0] == std::byte(decoded & 0xff) && body[length - 1] == body[0]);
+            const auto bytes = sizeof(length) + length;
+            wrapped += position % ring.capacity() + bytes > ring.capacity();
+            position += bytes;
+            offset += bytes;
+            ++decoded;
+        }
+        ring.consume(offset);
+        if (offset == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    assert(ring.empty());
+    assert(wrapped > 0); // the wrap path was exercised
+}
+
+int main()
+{
+    mirror_aliases_both_halves();
+    spsc_on_mirror_storage();
+    byte_ring_streams_variable_length_records();
+
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <lockedin/object_pool.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+struct Tracked
+{
+    static inline std::atomic<int> alive = 0;
+    static constexpr std::uint64_t poison = UINT64_MAX;
+
+    std::uint64_t id;
+    char payload[200];
+
+    explicit Tracked(std::uint64_t i) : id{i}, payload{}
+    {
+        if (i == poison)
+            throw std::runtime_error("bad id");
+        ++alive;
+    }
+
+    ~Tracked()
+    {
+        --alive;
+    }
+};
+
+static void make_and_release()
+{
+    lockedin::ObjectPool<Tracked> pool(2);
+    auto alloc = pool.getAllocator();
+
+    auto a = alloc.make(1);
+    auto b = alloc.make(2);
+    assert(a && b && a->id == 1 && (*b).id == 2 && Tracked::alive == 2);
+    assert(!alloc.make(3)); // exhausted
+
+    a.reset();
+    assert(!a && Tracked::alive == 1);
+    auto c = alloc.make(3); // the freed slot is picked up again
+    assert(c && c->id == 3);
+
+    lockedin::PooledPtr<Tracked> moved = std::move(c);
+    assert(!c && moved->id == 3);
+    b = std::move(moved);
+    assert(b->id == 3 && Tracked::alive == 1);
+}
+
+static void throwing_constructor_keeps_the_slot()
+{
+    lockedin::ObjectPool<Tracked> pool(1);
+    auto alloc = pool.getAllocator();
+
+    bool threw = false;
+    try
+    {
+        [[maybe_unused]] auto p = alloc.make(Tracked::poison);
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+    assert(alloc.make(1));
+}
+
+static void allocator_returns_its_cache()
+{
+    lockedin::ObjectPool<Tracked> pool(4);
+    {
+        auto first = pool.getAllocator();
+        [[maybe_unused]] auto p = first.make(1); // pulls a batch of free slots into `first`
+    }
+    auto second = pool.getAllocator();
+    for (std::uint64_t i = 0; i < 4; ++i)
+        assert(second.make(i));
+}
+
+// The first allocator to refill takes one batch, not the whole pool.
+static void allocators_share_the_pool()
+{
+    constexpr auto batch = lockedin::PoolAllocator<Tracked>::RefillBatch;
+    lockedin::ObjectPool<Tracked> pool(batch + 2);
+    auto first = pool.getAllocator();
+    auto second = pool.getAllocator();
+
+    auto a = first.make(1);
+    auto b = second.make(2);
+    auto c = second.make(3);
+    assert(a && b && c);
+    assert(!second.make(4)); // the rest sits in `first`'s cache
+}
+
+static void invalid_capacity_throws()
+{
+    bool threw = false;
+    try
+    {
+        lockedin::ObjectPool<Tracked> pool(0);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// Producer allocates, consumer frees: the pool is smaller than the traffic, so slots must
+// cycle back through the return stack.
+static void pointers_travel_through_a_queue()
+{
+    constexpr std::uint64_t n = 200'000;
+    lockedin::ObjectPool<Tracked> pool(64);
+    lockedin::SPSCQ<lockedin::PooledPtr<Tracked>> queue(32);
+
+    std::thread consumer(
+        [&]
+        {
+            lockedin::PooledPtr<Tracked> p;
+            for (std::uint64_t expected = 0; expected < n;)
+            {
+                if (!queue.pop(p))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                assert(p->id == expected);
+                p.reset();
+                ++expected;
+            }
+        });
+
+    auto alloc = pool.getAllocator();
+    for (std::uint64_t i = 0; i < n; ++i)
+    {
+        auto p = alloc.make(i);
+        while (!p)
+        {
+            std::this_thread::yield();
+            p = alloc.make(i);
+        }
+        while (!queue.push(std::move(p)))
+            std::this_thread::yield();
+    }
+    consumer.join();
+    assert(Tracked::alive == 0);
+}
+
+int main()
+{
+    make_and_release();
+    throwing_constructor_keeps_the_slot();
+    allocator_returns_its_cache();
+    allocators_share_the_pool();
+    invalid_capacity_throws();
+    pointers_travel_through_a_queue();
+    assert(Tracked::alive == 0);
+
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <lockedin/priority_queue.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static void urgent_lanes_pop_first()
+{
+    lockedin::PriorityMPSCQ<int, 3> q(8);
+    assert(q.empty());
+
+    assert(q.push(20, 2));
+    assert(q.push(10, 1));
+    assert(q.push(11, 1));
+    assert(q.push(0, 0));
+
+    int v = 0;
+    std::size_t lane = 99;
+    assert(q.pop(v, lane) && v == 0 && lane == 0);
+    assert(q.pop(v) && v == 10);
+    assert(q.push(1, 0)); // cancel arrives later but still jumps the queue
+    assert(q.pop(v) && v == 1);
+    assert(q.pop(v) && v == 11);
+    assert(q.pop(v, lane) && v == 20 && lane == 2);
+    assert(!q.pop(v) && q.empty());
+}
+
+static void lanes_fill_independently()
+{
+    lockedin::PriorityMPSCQ<int, 2> q(2);
+    assert(q.push(1, 0) && q.push(2, 0));
+    assert(!q.push(3, 0));
+    assert(q.push(3, 1));
+}
+
+static void starvation_limit_serves_waiting_lanes()
+{
+    lockedin::PriorityMPSCQ<int, 3> q(64, 4);
+    for (int i = 0; i < 20; ++i)
+        assert(q.push(0, 0));
+    assert(q.push(1, 1));
+    assert(q.push(2, 2));
+
+    // 4 urgent pops, then lane 1, 4 urgent pops, then lane 2.
+    std::vector<std::size_t> order;
+    int v = 0;
+    std::size_t lane = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        assert(q.pop(v, lane));
+        order.push_back(lane);
+    }
+    const std::vector<std::size_t> expected{0, 0, 0, 0, 1, 0, 0, 0, 0, 2};
+    assert(order == expected);
+}
+
+static void invalid_capacity_throws()
+{
+    bool threw = false;
+    try
+    {
+        lockedin::PriorityMPSCQ<int> q(3);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// Several producers per lane: nothing is lost and each producer's order holds within its lane.
+static void concurrent_producers()
+{
+    constexpr std::size_t lanes = 4;
+    constexpr std::size_t producers = 4;
+    constexpr std::uint64_t per_producer = 50'000;
+    lockedin::PriorityMPSCQ<std::uint64_t, lanes> q(1024);
+
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p)
+        threads.emplace_back(
+            [&, p]
+            {
+                for (std::uint64_t i = 0; i < per_producer; ++i)
+                    while (!q.push((p << 32) | i, p % lanes))
+                        std::this_thread::yield();
+            });
+
+    std::vector<std::uint64_t> next(producers, 0);
+    std::uint64_t v = 0;
+    std::size_t lane = 0;
+    for (std::uint64_t received = 0; received < producers * per_producer;)
+    {
+        if (!q.pop(v, lane))
+            continue;
+        const auto p = static_cast<std::size_t>(v >> 32);
+        assert(lane == p % lanes && (v & 0xffffffff) == next[p]);
+        ++next[p];
+        ++received;
+    }
+    for (auto& t : threads)
+        t.join();
+    assert(!q.pop(v));
+}
+
+int main()
+{
+    urgent_lanes_pop_first();
+    lanes_fill_independently();
+    starvation_limit_serves_waiting_lanes();
+    invalid_capacity_throws();
+    concurrent_producers();
+
+    std::cout << "PASSED\n";
+    return 0;
+}
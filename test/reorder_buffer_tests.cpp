@@ -0,0 +1,113 @@
+#include <lockedin/reorder_buffer.hpp>
+#include <lockedin/spsc_queue.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void out_of_order_deposits_come_out_in_order()
+{
+    lockedin::ReorderBuffer<std::string> rob(4, 10);
+    std::string s;
+
+    assert(rob.deposit(12, "c"));
+    assert(rob.deposit(11, "b"));
+    assert(!rob.pop(s));           // 10 still missing
+    assert(!rob.deposit(14, "e")); // outside the window [10, 14)
+
+    assert(rob.deposit(10, "a"));
+    std::string order;
+    assert(rob.drain([&](std::string&& v, std::uint64_t) { order += v; }) == 3);
+    assert(order == "abc" && rob.next() == 13);
+
+    assert(rob.deposit(14, "e") && rob.deposit(16, "g")); // window moved to [13, 17)
+    assert(rob.deposit(13, "d"));
+    assert(rob.pop(s) && s == "d");
+    const auto expectE = [](std::string&& v, std::uint64_t seq) { assert(seq == 14 && v == "e"); };
+    assert(rob.drain(expectE) == 1);
+    assert(rob.deposit(15, "f") && rob.pop(s) && s == "f" && rob.pop(s) && s == "g");
+    assert(!rob.pop(s) && rob.next() == 17);
+
+    bool threw = false;
+    try
+    {
+        lockedin::ReorderBuffer<int> bad(6);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// One dispatcher fans sequenced work to per-worker SPSCQ inboxes; workers finish in any order
+// and the consumer still sees every result once, in input order.
+static void parallel_workers_are_resequenced()
+{
+    constexpr std::uint64_t count = 200'000;
+    constexpr int workers = 4;
+    lockedin::ReorderBuffer<std::uint64_t> rob(64);
+
+    std::vector<std::unique_ptr<lockedin::SPSCQ<std::uint64_t>>> inboxes;
+    for (int w = 0; w < workers; ++w)
+        inboxes.push_back(std::make_unique<lockedin::SPSCQ<std::uint64_t>>(16));
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < workers; ++w)
+    {
+        threads.emplace_back(
+            [&, w]
+            {
+                std::uint64_t seq = 0;
+                for (std::uint64_t done = w; done < count; done += workers)
+                {
+                    while (!inboxes[w]->pop(seq))
+                        std::this_thread::yield();
+                    if (seq % 7 == 0)
+                        std::this_thread::yield(); // uneven work
+                    while (!rob.deposit(seq, seq * 3))
+                        std::this_thread::yield();
+                }
+            });
+    }
+    threads.emplace_back(
+        [&]
+        {
+            for (std::uint64_t seq = 0; seq < count; ++seq)
+            {
+                while (!inboxes[seq % workers]->push(seq))
+                    std::this_thread::yield();
+            }
+        });
+
+    std::uint64_t expected = 0;
+    while (expected < count)
+    {
+        const auto n = rob.drain(
+            [&](std::uint64_t&& v, std::uint64_t seq)
+            {
+                assert(seq == expected && v == seq * 3);
+                ++expected;
+            });
+        if (n == 0)
+            std::this_thread::yield();
+    }
+    for (auto& t : threads)
+        t.join();
+    assert(rob.next() == count);
+}
+
+int main()
+{
+    out_of_order_deposits_come_out_in_order();
+    parallel_workers_are_resequenced();
+
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include <lockedin/sequencer.hpp>
+#include <lockedin/wait_strategy.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+struct Order
+{
+    std::int64_t id{-1};
+    std::int64_t journaled{-1};
+    std::int64_t replicated{-1};
+};
+
+static void gating_blocks_producer_until_consumed()
+{
+    lockedin::SequencedRing<int> ring(4);
+    auto& barrier = ring.newBarrier();
+    std::int64_t sum = 0;
+    lockedin::BatchEventProcessor consumer(ring, barrier,
+                                           [&](int& v, std::int64_t, bool) { sum += v; });
+    ring.addGatingSequences({&consumer.sequence()});
+
+    std::int64_t seq = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        assert(ring.tryNext(seq) && seq == i);
+        ring[seq] = i + 1;
+        ring.publish(seq);
+    }
+    assert(!ring.tryNext(seq)); // slowest consumer has not moved
+
+    assert(consumer.processAvailable() == 4);
+    assert(sum == 10);
+    assert(consumer.sequence().get() == 3);
+    assert(ring.tryNext(seq) && seq == 4);
+}
+
+static void dependent_stage_waits_for_upstream()
+{
+    lockedin::SequencedRing<Order> ring(8);
+    lockedin::BatchEventProcessor journal(ring, ring.newBarrier(),
+                                          [](Order& o, std::int64_t s, bool) { o.journaled = s; });
+    lockedin::BatchEventProcessor replicate(ring, ring.newBarrier({&journal.sequence()}),
+                                            [](Order& o, std::int64_t s, bool)
+                                            {
+                                                assert(o.journaled == s);
+                                                o.replicated = s;
+                                            });
+    ring.addGatingSequences({&replicate.sequence()});
+
+    ring.publishEvent([](Order& o, std::int64_t s) { o.id = s; });
+    ring.publishEvent([](Order& o, std::int64_t s) { o.id = s; });
+
+    assert(replicate.processAvailable() == 0); // journal has not run yet
+    assert(journal.processAvailable() == 2);
+    assert(replicate.processAvailable() == 2);
+    assert(ring[1].replicated == 1);
+}
+
+static void batches_report_end_of_batch()
+{
+    lockedin::SequencedRing<int> ring(16);
+    int batches = 0;
+    int events = 0;
+    lockedin::BatchEventProcessor consumer(ring, ring.newBarrier(),
+                                           [&](int&, std::int64_t, bool endOfBatch)
+                                           {
+                                               ++events;
+                                               batches += endOfBatch;
+                                           });
+    ring.addGatingSequences({&consumer.sequence()});
+
+    std::int64_t seq = 0;
+    assert(ring.tryNext(seq, 5) && seq == 4); // claim five at once
+    ring.publish(seq);
+    consumer.processAvailable();
+    assert(events == 5 && batches == 1);
+}
+
+static void invalid_capacity_throws()
+{
+    bool threw = false;
+    try
+    {
+        lockedin::SequencedRing<int> ring(6);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// A halt() that lands before the thread reaches run() must still stop it.
+static void halt_before_run_is_not_lost()
+{
+    lockedin::SequencedRing<int, lockedin::BlockingWait<>> ring(8);
+    lockedin::BatchEventProcessor consumer(ring, ring.newBarrier(),
+                                           [](int&, std::int64_t, bool) {});
+    ring.addGatingSequences({&consumer.sequence()});
+
+    consumer.halt();
+    std::thread early([&] { consumer.run(); });
+    early.join();
+    assert(!consumer.isRunning());
+
+    // The processor is idle again and can run and be halted normally.
+    std::thread worker([&] { consumer.run(); });
+    ring.publishEvent([](int& v, std::int64_t) { v = 1; });
+    while (consumer.sequence().get() != 0)
+        std::this_thread::yield();
+    consumer.halt();
+    worker.join();
+    assert(!consumer.isRunning());
+}
+
+// journal -> replicate -> business across threads; the ring is much smaller than the stream.
+template <typename Wait> static void threaded_pipeline_is_lossless()
+{
+    constexpr std::int64_t n = 100'000;
+    lockedin::SequencedRing<Order, Wait> ring(64);
+
+    lockedin::BatchEventProcessor journal(ring, ring.newBarrier(),
+                                          [](Order& o, std::int64_t s, bool) { o.journaled = s; });
+    lockedin::BatchEventProcessor replicate(ring, ring.newBarrier({&journal.sequence()}),
+                                            [](Order& o, std::int64_t s, bool)
+                                            {
+                                                assert(o.journaled == s);
+                                                o.replicated = s;
+                                            });
+    std::int64_t expected = 0;
+    std::int64_t sum = 0;
+    lockedin::BatchEventProcessor business(ring, ring.newBarrier({&replicate.sequence()}),
+                                           [&](Order& o, std::int64_t s, bool)
+                                           {
+                                               assert(o.replicated == s && o.id == expected);
+                                               ++expected;
+                                               sum += o.id;
+                                           });
+    ring.addGatingSequences({&business.sequence()});
+
+    std::thread t1([&] { journal.run(); });
+    std::thread t2([&] { replicate.run(); });
+    std::thread t3([&] { business.run(); });
+
+    for (std::int64_t i = 0; i < n; ++i)
+        ring.publishEvent([i](Order& o, std::int64_t) { o.id = i; });
+
+    while (business.sequence().get() != n - 1)
+        std::this_thread::yield();
+    journal.halt();
+    replicate.halt();
+    business.halt();
+    t1.join();
+    t2.join();
+    t3.join();
+
+    assert(expected == n);
+    assert(sum == n * (n - 1) / 2);
+}
+
+int main()
+{
+    gating_blocks_producer_until_consumed();
+    dependent_stage_waits_for_upstream();
+    batches_report_end_of_batch();
+    invalid_capacity_throws();
+    halt_before_run_is_not_lost();
+    threaded_pipeline_is_lossless<lockedin::YieldingWait>();
+    threaded_pipeline_is_lossless<lockedin::BlockingWait<>>();
+
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -1,7 +1,9 @@
 #include <lockedin/spmc_queue.hpp>
 
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <thread>
 #include <vector>
@@ -135,11 +137,407 @@ static void overlapping_consumer_does_not_break_others()
         assert(fast_seen[i] == i);
 }
 
+static void stats_track_producer_and_each_consumer()
+{
+    lockedin::SPMCQ<int, lockedin::QueueStats<1>> q{4};
+    auto prod = q.getProducer();
+    auto cons = q.getConsumer();
+
+    int v = 0;
+    assert(!cons.pop(v));
+    for (int i = 0; i < 6; ++i)
+        assert(prod.push(i));
+
+    bool overlapped = false;
+    try
+    {
+        (void)cons.pop(v);
+    }
+    catch (const std::runtime_error&)
+    {
+        overlapped = true;
+    }
+    assert(overlapped);
+
+    const auto produced = q.stats();
+    assert(produced.pushes == 6);
+    assert(produced.highWater == 4);
+
+    const auto consumed = cons.stats();
+    assert(consumed.emptyHits == 1);
+    assert(consumed.overruns == 1);
+    assert(consumed.pops == 0);
+}
+
+// A reliable consumer holds the producer back instead of being overlapped.
+static void reliable_consumer_gates_producer()
+{
+    lockedin::SPMCQ<int, lockedin::QueueStats<1>> q{4};
+    auto prod = q.getProducer();
+    auto lossy = q.getConsumer(); // never gates the producer
+    auto audit = q.getReliableConsumer();
+    assert(audit.reliable() && !lossy.reliable());
+
+    for (int i = 0; i < 4; ++i)
+        assert(prod.push(i));
+    assert(!prod.push(4)); // audit has not read slot 0 yet
+    assert(q.stats().fullHits == 1);
+
+    int v = 0;
+    assert(audit.pop(v) && v == 0);
+    assert(prod.push(4));
+
+    {
+        auto copy = audit; // registers its own cursor at the same position
+        assert(copy.reliable());
+        for (int expected = 1; expected <= 4; ++expected)
+            assert(copy.pop(v) && v == expected);
+        assert(!prod.push(5)); // original audit still gates
+    }
+    for (int expected = 1; expected <= 4; ++expected)
+        assert(audit.pop(v) && v == expected);
+    assert(prod.push(5));
+}
+
+static void reliable_consumer_joins_at_tail()
+{
+    lockedin::SPMCQ<int> q{4, 1};
+    auto prod = q.getProducer();
+    for (int i = 0; i < 6; ++i)
+        assert(prod.push(i));
+
+    {
+        auto late = q.getReliableConsumer();
+        int v = 0;
+        assert(!late.pop(v)); // nothing before the join is replayed
+        assert(prod.push(6));
+        assert(late.pop(v) && v == 6);
+
+        bool threw = false;
+        try
+        {
+            (void)q.getReliableConsumer(); // registry has one slot
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+    auto again = q.getReliableConsumer(); // slot released on destruction
+    assert(again.reliable());
+}
+
+// The producer outruns a small ring many times over; the reliable consumer sees every message.
+static void reliable_consumer_never_loses_messages()
+{
+    constexpr int N = 200'000;
+    lockedin::SPMCQ<int> q{16};
+    auto audit = q.getReliableConsumer();
+
+    std::thread consumer(
+        [&]
+        {
+            int v = 0;
+            for (int expected = 0; expected < N;)
+            {
+                if (!audit.pop(v))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                assert(v == expected);
+                ++expected;
+            }
+        });
+
+    auto p = q.getProducer();
+    for (int i = 0; i < N; ++i)
+        while (!p.push(i))
+            std::this_thread::yield();
+    consumer.join();
+}
+
+static void consumers_join_at_tail_oldest_or_sequence()
+{
+    lockedin::SPMCQ<int> q{8};
+    auto prod = q.getProducer();
+    for (int i = 0; i < 20; ++i)
+        assert(prod.push(i));
+    assert(q.sequence() == 20 && q.oldest() == 13);
+
+    int v = 0;
+    auto oldest = q.getConsumer(lockedin::SPMCJoin::Oldest);
+    assert(oldest.position() == 13);
+    assert(oldest.pop(v) && v == 13);
+
+    auto tail = q.getConsumer(lockedin::SPMCJoin::Tail);
+    assert(!tail.pop(v));
+
+    auto at = q.getConsumerAt(17);
+    assert(at.pop(v) && v == 17);
+
+    auto future = q.getConsumerAt(22);
+    assert(!future.pop(v));
+    assert(prod.push(20) && prod.push(21) && prod.push(22));
+    assert(future.pop(v) && v == 22);
+    assert(tail.pop(v) && v == 20);
+
+    bool threw = false;
+    try
+    {
+        (void)q.getConsumerAt(5);
+    }
+    catch (const std::out_of_range&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+static void detach_releases_the_producer()
+{
+    lockedin::SPMCQ<int> q{4};
+    auto prod = q.getProducer();
+    for (int i = 0; i < 3; ++i)
+        assert(prod.push(i));
+
+    auto replay = q.getConsumer(lockedin::SPMCJoin::Oldest, lockedin::SPMCMode::Reliable);
+    assert(q.reliableConsumers() == 1);
+    int v = 0;
+    assert(replay.pop(v) && v == 0);
+    assert(prod.push(3) && prod.push(4));
+    assert(!prod.push(5)); // replay still needs message 1
+
+    replay.detach();
+    assert(!replay.reliable() && q.reliableConsumers() == 0);
+    assert(prod.push(5));
+}
+
+// A reliable join behind the producer's cached minimum waits for the producer's next push,
+// which rescans the registry, so the joined messages are never overwritten.
+static void reliable_join_behind_the_tail_is_exact()
+{
+    lockedin::SPMCQ<int> q{8};
+    auto prod = q.getProducer();
+    for (int i = 0; i < 20; ++i)
+        assert(prod.push(i)); // wraps twice with nobody gating
+
+    constexpr int total = 2000;
+    std::atomic<bool> joined{false};
+    std::thread reader(
+        [&]
+        {
+            auto oldest = q.getConsumer(lockedin::SPMCJoin::Oldest, lockedin::SPMCMode::Reliable);
+            // `oldest` now holds the producer back, so its position stays retained
+            auto at = q.getConsumerAt(oldest.position(), lockedin::SPMCMode::Reliable);
+            assert(at.position() == oldest.position());
+            joined = true;
+            int v = 0;
+            std::uint64_t seq = 0;
+            while (at.position() < total || oldest.position() < total)
+            {
+                bool progressed = false;
+                for (auto* consumer : {&at, &oldest})
+                {
+                    if (consumer->position() < total && consumer->pop(v, seq)) // never overruns
+                    {
+                        assert(static_cast<std::uint64_t>(v) == seq);
+                        progressed = true;
+                    }
+                }
+                if (!progressed)
+                    std::this_thread::yield();
+            }
+        });
+
+    int next = 20;
+    for (; !joined; std::this_thread::yield())
+        next += prod.push(next) ? 1 : 0;
+    for (; next < total; std::this_thread::yield())
+        next += prod.push(next) ? 1 : 0;
+    reader.join();
+}
+
+static void history_is_addressable_by_sequence()
+{
+    lockedin::SPMCQ<int> q{8};
+    auto prod = q.getProducer();
+    auto cons = q.getConsumer();
+    for (int i = 0; i < 12; ++i)
+        assert(prod.push(i * 10));
+
+    int v = 0;
+    std::uint64_t seq = 0;
+    bool overlapped = false;
+    try
+    {
+        (void)cons.pop(v, seq);
+    }
+    catch (const std::runtime_error&)
+    {
+        overlapped = true; // sequences 0..3 are gone
+    }
+    assert(overlapped);
+    cons.respawn();
+    assert(!cons.pop(v, seq));
+
+    assert(q.readAt(11, v) && v == 110);
+    assert(q.readAt(5, v) && v == 50);
+    assert(!q.readAt(3, v));  // overwritten
+    assert(!q.readAt(12, v)); // not published yet
+
+    std::vector<std::uint64_t> seqs;
+    const auto next = q.readRange(0, 100,
+                                  [&](std::uint64_t s, const int& value)
+                                  {
+                                      assert(value == static_cast<int>(s) * 10);
+                                      seqs.push_back(s);
+                                  });
+    assert(next == 12);
+    assert(seqs.size() == 7 && seqs.front() == 5 && seqs.back() == 11);
+
+    assert(prod.push(120));
+    assert(cons.pop(v, seq) && v == 120 && seq == 12);
+}
+
+static void batch_views_consume_without_copying()
+{
+    lockedin::SPMCQ<int, lockedin::QueueStats<1>> q{8};
+    auto prod = q.getProducer();
+    auto cons = q.getReliableConsumer();
+    for (int i = 0; i < 6; ++i)
+        assert(prod.push(i));
+
+    int seen = 0;
+    assert(cons.peek([&](const int& v) { seen = v; }) && seen == 0);
+    assert(cons.position() == 0); // peek does not consume
+
+    std::vector<int> got;
+    const auto take = [&](const lockedin::SPMCView<int>& view, std::uint64_t first)
+    {
+        assert(static_cast<int>(first) == (got.empty() ? 0 : got.back() + 1));
+        for (const int& v : view)
+            got.push_back(v);
+    };
+    assert(cons.readBatch(take, 4) == 4);
+    assert(got == (std::vector<int>{0, 1, 2, 3}));
+
+    // Next batch wraps around the end of the ring: two contiguous views.
+    for (int i = 6; i < 10; ++i)
+        assert(prod.push(i));
+    int views = 0;
+    assert(cons.readBatch(
+               [&](const lockedin::SPMCView<int>& view, std::uint64_t first)
+               {
+                   ++views;
+                   take(view, first);
+               }) == 6);
+    assert(views == 2);
+    assert(got.size() == 10 && got.back() == 9);
+    assert(cons.readBatch(take) == 0);
+    assert(!cons.peek([](const int&) {}));
+    assert(cons.stats().pops == 10);
+
+    auto lossy = q.getConsumerAt(q.oldest());
+    cons.detach();
+    for (int i = 10; i < 20; ++i)
+        assert(prod.push(i));
+    bool overlapped = false;
+    try
+    {
+        (void)lossy.readBatch(take);
+    }
+    catch (const std::runtime_error&)
+    {
+        overlapped = true;
+    }
+    assert(overlapped);
+}
+
+// Payload that counts how often it is copied out of the ring.
+struct Quote
+{
+    static inline int copies = 0;
+
+    std::uint64_t instrument{0};
+    std::uint64_t sequence{0};
+
+    Quote() = default;
+    Quote(std::uint64_t i, std::uint64_t s) : instrument{i}, sequence{s}
+    {
+    }
+    Quote(const Quote&) = default;
+    Quote& operator=(const Quote& other)
+    {
+        ++copies;
+        instrument = other.instrument;
+        sequence = other.sequence;
+        return *this;
+    }
+};
+
+static void topic_filters_skip_without_copying()
+{
+    lockedin::SPMCQ<Quote> q{8};
+    auto prod = q.getProducer();
+    auto cons = q.getReliableConsumer();
+    const auto wanted = [](std::uint64_t tag) { return tag == 3 || tag == 5; };
+
+    for (std::uint64_t i = 0; i < 7; ++i)
+        assert(prod.push(Quote{i, i}, i)); // tag = instrument
+    Quote::copies = 0;
+
+    Quote quote;
+    assert(cons.popMatching(quote, wanted) && quote.instrument == 3);
+    assert(cons.position() == 4 && Quote::copies == 1); // 0..2 skipped, never copied
+    assert(cons.skipNonMatching(wanted) == 1);          // skips 4, stops at 5 unconsumed
+    assert(cons.position() == 5);
+    assert(cons.popMatching(quote, wanted) && quote.instrument == 5);
+    assert(!cons.popMatching(quote, wanted)); // 6 is skipped, nothing else published
+    assert(cons.position() == 7 && Quote::copies == 2);
+
+    // Skipped slots were released: the producer can reuse the whole ring.
+    for (std::uint64_t i = 0; i < 7; ++i)
+        assert(prod.push(Quote{9, 7 + i}, 9));
+    assert(cons.skipNonMatching(wanted, 3) == 3); // bounded scan
+    assert(!cons.popMatching(quote, wanted, 2) && cons.position() == 12);
+
+    // Untagged pushes carry tag 0; a lossy consumer that falls behind still overruns.
+    auto lossy = q.getConsumerAt(q.oldest());
+    cons.detach();
+    for (std::uint64_t i = 0; i < 16; ++i)
+        assert(prod.push(Quote{0, i}));
+    bool overlapped = false;
+    try
+    {
+        (void)lossy.skipNonMatching(wanted);
+    }
+    catch (const std::runtime_error&)
+    {
+        overlapped = true;
+    }
+    assert(overlapped);
+    lossy.respawn();
+    assert(prod.push(Quote{5, 0}, 5));
+    assert(lossy.popMatching(quote, wanted) && quote.instrument == 5);
+}
+
 int main()
 {
     single_thread_smoke();
     order_consistent_across_consumers();
     overlapping_consumer_does_not_break_others();
+    stats_track_producer_and_each_consumer();
+    reliable_consumer_gates_producer();
+    reliable_consumer_joins_at_tail();
+    reliable_consumer_never_loses_messages();
+    consumers_join_at_tail_oldest_or_sequence();
+    detach_releases_the_producer();
+    reliable_join_behind_the_tail_is_exact();
+    history_is_addressable_by_sequence();
+    batch_views_consume_without_copying();
+    topic_filters_skip_without_copying();
     std::cout << "PASSED\n";
     return 0;
 }
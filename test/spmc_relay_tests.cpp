@@ -0,0 +1,152 @@
+#include <lockedin/cpu_topology.hpp>
+#include <lockedin/spmc_relay.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Every CPU this process may use, split into `sockets` emulated sockets (CPUs are reused when
+// there are fewer CPUs than sockets).
+static lockedin::CpuTopology emulated(std::size_t sockets)
+{
+    const auto cpus = lockedin::CpuTopology::detect().cpus(0);
+    std::vector<std::vector<int>> layout(sockets);
+    for (std::size_t s = 0; s < sockets; ++s)
+        layout[s].push_back(cpus[s % cpus.size()]);
+    return lockedin::CpuTopology(layout);
+}
+
+static void topology_detection()
+{
+    const auto topology = lockedin::CpuTopology::detect();
+    assert(topology.sockets() >= 1 && !topology.cpus(0).empty());
+    assert(topology.currentSocket() < topology.sockets());
+
+    const lockedin::CpuTopology manual({{0, 1}, {2, 3}});
+    assert(manual.socketOf(3) == 1 && manual.socketOf(42) == 0);
+
+    bool threw = false;
+    try
+    {
+        lockedin::CpuTopology empty({{0}, {}});
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// Consumers on every socket see the whole stream in order; the reliable relays keep up with a
+// primary much smaller than the stream.
+static void reliable_relays_deliver_everything()
+{
+    constexpr std::uint64_t count = 100'000;
+    lockedin::SPMCQ<std::uint64_t> primary(64);
+    lockedin::SPMCRelay<std::uint64_t, lockedin::YieldingWait> relay(
+        primary, emulated(3), 0, lockedin::SPMCMode::Reliable, 1024);
+    assert(primary.reliableConsumers() == 2);
+    assert(&relay.ring(0) == &primary && &relay.ring(1) != &relay.ring(2));
+
+    std::vector<std::thread> consumers;
+    for (std::size_t s = 0; s < 3; ++s)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            consumers.emplace_back(
+                [consumer = relay.getConsumer(s, lockedin::SPMCJoin::Tail,
+                                              lockedin::SPMCMode::Reliable)]() mutable
+                {
+                    std::uint64_t value = 0;
+                    for (std::uint64_t expected = 0; expected < count; ++expected)
+                    {
+                        while (!consumer.pop(value))
+                            std::this_thread::yield();
+                        assert(value == expected);
+                    }
+                });
+        }
+    }
+
+    auto producer = primary.getProducer();
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        while (!producer.push(i))
+            std::this_thread::yield();
+    }
+    for (auto& consumer : consumers)
+        consumer.join();
+
+    relay.stop();
+    relay.stop();
+    assert(relay.relayed(1) == count && relay.relayed(2) == count);
+    assert(relay.overruns(1) == 0 && relay.relayed(0) == 0);
+    assert(primary.reliableConsumers() == 2); // the relays stay registered until destruction
+}
+
+// A lossy relay never slows the producer; whatever reaches the replica is in order.
+static void lossy_relay_keeps_order()
+{
+    constexpr std::uint64_t count = 50'000;
+    lockedin::SPMCQ<std::uint64_t> primary(16);
+    lockedin::SPMCRelay<std::uint64_t, lockedin::YieldingWait> relay(
+        primary, emulated(2), 0, lockedin::SPMCMode::Lossy, 1 << 16);
+    assert(primary.reliableConsumers() == 0);
+    auto consumer = relay.getConsumer(1, lockedin::SPMCJoin::Tail);
+
+    auto producer = primary.getProducer();
+    for (std::uint64_t i = 0; i < count; ++i)
+        assert(producer.push(i)); // never waits for the relay
+    relay.stop();                 // relays what is still in the primary, unless lapped
+
+    std::uint64_t value = 0;
+    std::uint64_t received = 0;
+    for (std::uint64_t previous = 0; consumer.pop(value); previous = value, ++received)
+        assert(received == 0 || value > previous);
+    assert(received == relay.relayed(1));
+    assert(received == count || relay.overruns(1) > 0);
+}
+
+// A failed construction starts no thread and releases the relay cursors it already claimed.
+static void failed_construction_cleans_up()
+{
+    lockedin::SPMCQ<std::uint64_t> primary(64, 1);
+
+    bool threw = false;
+    try
+    {
+        lockedin::SPMCRelay<std::uint64_t> relay(primary, emulated(2), 0,
+                                                 lockedin::SPMCMode::Lossy, 48);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try
+    {
+        lockedin::SPMCRelay<std::uint64_t> relay(primary, emulated(3), 0,
+                                                 lockedin::SPMCMode::Reliable);
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    assert(threw && primary.reliableConsumers() == 0);
+}
+
+int main()
+{
+    topology_detection();
+    reliable_relays_deliver_everything();
+    lossy_relay_keeps_order();
+    failed_construction_cleans_up();
+
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <lockedin/abstract_queue.hpp>
+#include <lockedin/wait_strategy.hpp>
+#include <lockedin/work_stealing_deque.hpp>
+#include <lockedin/work_stealing_scheduler.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static_assert(lockedin::detail::QueueInterface<lockedin::ChaseLevDeque<int>, int>);
+
+// Owner sees LIFO, thieves see FIFO.
+static void deque_single_thread_semantics()
+{
+    lockedin::ChaseLevDeque<int> dq{4};
+    assert(dq.empty());
+    for (int i = 1; i <= 4; ++i)
+        assert(dq.push(i));
+    assert(dq.full());
+    assert(!dq.push(5));
+
+    int v = 0;
+    assert(dq.steal(v) && v == 1);
+    assert(dq.pop(v) && v == 4);
+    assert(dq.steal(v) && v == 2);
+    assert(dq.pop(v) && v == 3);
+    assert(!dq.pop(v));
+    assert(!dq.steal(v));
+    assert(dq.empty());
+}
+
+// Every pushed element is taken exactly once by the owner or one of the thieves.
+static void deque_concurrent_exactly_once()
+{
+    constexpr int total = 200000;
+    constexpr int thieves = 3;
+    lockedin::ChaseLevDeque<int> dq{256};
+    std::vector<std::atomic<int>> taken(total);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; ++t)
+        threads.emplace_back(
+            [&]
+            {
+                int v = 0;
+                while (!done.load(std::memory_order_acquire) || !dq.empty())
+                    if (dq.steal(v))
+                        taken[v].fetch_add(1, std::memory_order_relaxed);
+                    else
+                        std::this_thread::yield();
+            });
+
+    int v = 0;
+    for (int i = 0; i < total; ++i)
+    {
+        while (!dq.push(i))
+            if (dq.pop(v))
+                taken[v].fetch_add(1, std::memory_order_relaxed);
+        if (i % 3 == 0 && dq.pop(v))
+            taken[v].fetch_add(1, std::memory_order_relaxed);
+    }
+    while (dq.pop(v))
+        taken[v].fetch_add(1, std::memory_order_relaxed);
+    done = true;
+    for (auto& t : threads)
+        t.join();
+
+    for (int i = 0; i < total; ++i)
+        assert(taken[i].load() == 1);
+}
+
+template <typename Wait> static void parallel_for_covers_range_once()
+{
+    constexpr std::size_t n = 100000;
+    std::vector<std::atomic<int>> hits(n);
+    lockedin::WorkStealingScheduler<Wait> scheduler(3, 64);
+
+    for (int round = 0; round < 3; ++round)
+        scheduler.parallel_for(0, n, 64,
+                               [&](std::size_t lo, std::size_t hi)
+                               {
+                                   assert(hi - lo <= 64);
+                                   for (auto i = lo; i < hi; ++i)
+                                       hits[i].fetch_add(1, std::memory_order_relaxed);
+                               });
+
+    for (std::size_t i = 0; i < n; ++i)
+        assert(hits[i].load() == 3);
+}
+
+// A deque too small for the fork depth runs the rest serially, still in grain-sized pieces.
+static void full_deque_keeps_grain()
+{
+    constexpr std::size_t n = 100000;
+    std::atomic<std::size_t> covered{0};
+    lockedin::WorkStealingScheduler<> scheduler(2, 2);
+
+    scheduler.parallel_for(0, n, 8,
+                           [&](std::size_t lo, std::size_t hi)
+                           {
+                               assert(hi > lo && hi - lo <= 8);
+                               covered.fetch_add(hi - lo, std::memory_order_relaxed);
+                           });
+
+    assert(covered.load() == n);
+}
+
+// parallel_for called from inside a job forks onto the calling worker's deque.
+static void nested_parallel_for()
+{
+    constexpr std::size_t outer = 64;
+    constexpr std::size_t inner = 256;
+    std::atomic<std::size_t> sum{0};
+    lockedin::WorkStealingScheduler<> scheduler(2, 32);
+
+    scheduler.parallel_for(0, outer, 1,
+                           [&](std::size_t lo, std::size_t hi)
+                           {
+                               for (auto o = lo; o < hi; ++o)
+                                   scheduler.parallel_for(
+                                       0, inner, 16,
+                                       [&](std::size_t a, std::size_t b)
+                                       { sum.fetch_add(b - a, std::memory_order_relaxed); });
+                           });
+
+    assert(sum.load() == outer * inner);
+}
+
+int main()
+{
+    deque_single_thread_semantics();
+    deque_concurrent_exactly_once();
+    parallel_for_covers_range_once<lockedin::BackoffWait<>>();
+    parallel_for_covers_range_once<lockedin::BlockingWait<>>();
+    full_deque_keeps_grain();
+    nested_parallel_for();
+    std::cout << "PASSED\n";
+    return 0;
+}